@@ -7,8 +7,12 @@ module l1_arbiter (
     // I-Cache Interface (Read Only)
     input wire [31:0] icache_addr,
     input wire        icache_req,
+    input wire        icache_burst,
+    input wire        icache_prefetch, // Low priority: only granted while the D-Cache is quiet
+    input wire        icache_abort,    // The I-Cache abandons its prefetch burst (demand miss)
     output reg [31:0] icache_rdata,
     output reg        icache_ready,
+    output reg        icache_preempted, // The prefetch burst was dropped for a D-Cache request
 
     // D-Cache Interface (Read/Write)
     input wire [31:0] dcache_addr,
@@ -16,6 +20,8 @@ module l1_arbiter (
     input wire [3:0]  dcache_be,
     input wire        dcache_we,
     input wire        dcache_req,
+    input wire        dcache_burst,
+    input wire        dcache_abort,    // The D-Cache abandons its prefetch burst (demand access)
     output reg [31:0] dcache_rdata,
     output reg        dcache_ready,
 
@@ -25,6 +31,8 @@ module l1_arbiter (
     output reg [3:0]  m_be,
     output reg        m_we,
     output reg        m_req,
+    output reg        m_burst,
+    output reg        m_abort, // Ends the burst in flight early; a new request may start with it
     input wire [31:0] m_rdata,
     input wire        m_ready
 );
@@ -36,12 +44,28 @@ module l1_arbiter (
 
     reg [1:0] state, next_state;
 
+    // Burst beats received; the grant is held until the last one
+    reg [1:0] burst_beat;
+    wire      last_beat = (burst_beat == 2'd3);
+
+    // D-Cache requested last cycle: its next access may follow after a one-cycle gap,
+    // so a prefetch started now would most likely be preempted at once
+    reg       dcache_recent;
+
     // State Register
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             state <= STATE_IDLE;
+            burst_beat <= 0;
+            dcache_recent <= 0;
         end else begin
             state <= next_state;
+            dcache_recent <= dcache_req;
+            if (state == STATE_IDLE || m_abort) begin
+                burst_beat <= 0;
+            end else if (m_burst && m_ready) begin
+                burst_beat <= burst_beat + 1;
+            end
         end
     end
 
@@ -53,6 +77,7 @@ module l1_arbiter (
         // Cache Outputs
         icache_ready = 0;
         icache_rdata = 0;
+        icache_preempted = 0;
         dcache_ready = 0;
         dcache_rdata = 0;
 
@@ -62,6 +87,8 @@ module l1_arbiter (
         m_be = 0;
         m_we = 0;
         m_req = 0;
+        m_burst = 0;
+        m_abort = 0;
 
         case (state)
             STATE_IDLE: begin
@@ -77,7 +104,8 @@ module l1_arbiter (
                     m_be = dcache_be;
                     m_we = dcache_we;
                     m_req = 1;
-                end else if (icache_req) begin
+                    m_burst = dcache_burst;
+                end else if (icache_req && !(icache_prefetch && dcache_recent)) begin
                     next_state = STATE_ICACHE;
                     
                     m_addr = icache_addr;
@@ -85,36 +113,64 @@ module l1_arbiter (
                     m_be = 4'b1111; // Read all bytes
                     m_we = 0;
                     m_req = 1;
+                    m_burst = icache_burst;
                 end
             end
 
             STATE_DCACHE: begin
-                // Maintain connection to D-Cache
-                m_addr = dcache_addr;
-                m_wdata = dcache_wdata;
-                m_be = dcache_be;
-                m_we = dcache_we;
-                m_req = 1; // Keep request high until ready
-
-                if (m_ready) begin
-                    dcache_rdata = m_rdata;
-                    dcache_ready = 1;
+                if (dcache_abort) begin
+                    // The D-Cache dropped its prefetch for a demand access
+                    m_abort = 1;
                     next_state = STATE_IDLE;
+                end else begin
+                    // Maintain connection to D-Cache
+                    m_addr = dcache_addr;
+                    m_wdata = dcache_wdata;
+                    m_be = dcache_be;
+                    m_we = dcache_we;
+                    m_req = 1; // Keep request high until ready
+                    m_burst = dcache_burst;
+
+                    if (m_ready) begin
+                        dcache_rdata = m_rdata;
+                        dcache_ready = 1;
+                        if (!dcache_burst || last_beat) next_state = STATE_IDLE;
+                    end
                 end
             end
 
             STATE_ICACHE: begin
-                // Maintain connection to I-Cache
-                m_addr = icache_addr;
-                m_wdata = 0;
-                m_be = 4'b1111;
-                m_we = 0;
-                m_req = 1;
-
-                if (m_ready) begin
-                    icache_rdata = m_rdata;
-                    icache_ready = 1;
+                if (dcache_req && (icache_prefetch || icache_abort)) begin
+                    // A prefetch never delays the D-Cache: drop it and start the D-Cache
+                    // request in the same cycle, as from IDLE
+                    icache_preempted = 1;
+                    m_abort = 1;
+                    next_state = STATE_DCACHE;
+
+                    m_addr = dcache_addr;
+                    m_wdata = dcache_wdata;
+                    m_be = dcache_be;
+                    m_we = dcache_we;
+                    m_req = 1;
+                    m_burst = dcache_burst;
+                end else if (icache_abort) begin
+                    // The I-Cache dropped its prefetch for a demand miss
+                    m_abort = 1;
                     next_state = STATE_IDLE;
+                end else begin
+                    // Maintain connection to I-Cache
+                    m_addr = icache_addr;
+                    m_wdata = 0;
+                    m_be = 4'b1111;
+                    m_we = 0;
+                    m_req = 1;
+                    m_burst = icache_burst;
+
+                    if (m_ready) begin
+                        icache_rdata = m_rdata;
+                        icache_ready = 1;
+                        if (!icache_burst || last_beat) next_state = STATE_IDLE;
+                    end
                 end
             end
         endcase
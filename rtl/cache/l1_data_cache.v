@@ -4,6 +4,7 @@ module l1_data_cache (
 
     // CPU Interface
     input wire [31:0] cpu_address,
+    input wire [31:0] cpu_program_counter, // PC of the access (trains the stride prefetcher)
     input wire [31:0] cpu_write_data,
     input wire [3:0]  cpu_byte_enable,
     input wire        cpu_write_enable,
@@ -17,33 +18,166 @@ module l1_data_cache (
     output reg [3:0]  mem_byte_enable,
     output reg        mem_write_enable,
     output reg        mem_request,
+    output reg        mem_burst,
+    output reg        mem_abort, // The prefetch burst in flight is abandoned this cycle
     input wire [31:0] mem_read_data,
-    input wire        mem_ready
+    input wire        mem_ready,
+
+    output wire       demand_miss // A load or allocating store starts a refill this cycle (performance counters)
 );
 
     // Parameters
-    parameter NUM_SETS = 256; // 4KB / 16B
-    parameter INDEX_BITS = 8; // log2(256)
+    parameter NUM_WAYS = 2; // Associativity: 1 (direct-mapped), 2, 4 or 8
+    parameter CACHE_BYTES = 4096; // 4KB total, independent of associativity
     parameter OFFSET_BITS = 4; // 16 bytes
-    parameter TAG_BITS = 32 - INDEX_BITS - OFFSET_BITS; // 20 bits
+    parameter WRITE_BACK = 0; // 0: write-through, no-write-allocate; 1: write-back, write-allocate
+    parameter PREFETCH_ENABLE = 0; // PC-indexed stride prefetcher (0 removes it)
+    parameter PREFETCH_TABLE_ENTRIES = 16; // Stride table entries (power of two)
+    parameter PREFETCH_DEGREE = 2; // Lines prefetched per confirmed stride
+    parameter PREFETCH_DISTANCE = 1; // Strides ahead of the current access for the first prefetch
+
+    localparam NUM_SETS = CACHE_BYTES / 16 / NUM_WAYS; // 256 / NUM_WAYS
+    localparam INDEX_BITS = $clog2(NUM_SETS);
+    localparam TAG_BITS = 32 - INDEX_BITS - OFFSET_BITS;
+    localparam PLRU_LEVELS = $clog2(NUM_WAYS); // Depth of the PLRU tree
+    localparam WAY_BITS = (PLRU_LEVELS > 0) ? PLRU_LEVELS : 1;
+    localparam PLRU_BITS = (NUM_WAYS > 1) ? NUM_WAYS - 1 : 1;
+    localparam TABLE_BITS = $clog2(PREFETCH_TABLE_ENTRIES);
+
+    // Cache Storage (one bank per way)
+    reg valid [0:NUM_WAYS-1][0:NUM_SETS-1];
+    reg [TAG_BITS-1:0] tag_array [0:NUM_WAYS-1][0:NUM_SETS-1];
+    reg [127:0] data_array [0:NUM_WAYS-1][0:NUM_SETS-1]; // 16 bytes per block
+    reg dirty [0:NUM_WAYS-1][0:NUM_SETS-1]; // Line differs from memory (write-back only)
 
-    // Cache Storage
-    reg valid [0:NUM_SETS-1];
-    reg [TAG_BITS-1:0] tag_array [0:NUM_SETS-1];
-    reg [127:0] data_array [0:NUM_SETS-1]; // 16 bytes per block
+    // Tree pseudo-LRU state, one tree per set.
+    // Node n has children 2n+1 (left) and 2n+2 (right); a node bit of 0 points
+    // the victim search into the left subtree, 1 into the right subtree.
+    reg [PLRU_BITS-1:0] plru_tree [0:NUM_SETS-1];
 
     // Address Decomposition
     wire [INDEX_BITS-1:0] index = cpu_address[INDEX_BITS+OFFSET_BITS-1 : OFFSET_BITS];
     wire [TAG_BITS-1:0] tag = cpu_address[31 : 31-TAG_BITS+1];
     wire [1:0] word_offset = cpu_address[3:2];
 
-    // Hit Detection
-    wire valid_bit = valid[index];
-    wire [TAG_BITS-1:0] stored_tag = tag_array[index];
-    wire hit = valid_bit && (stored_tag == tag);
+    // Peripheral space (0x4000_0000 and up) is never allocated: stores there always write through.
+    // Cacheable refills are one 4-beat burst; peripheral reads keep one access per word.
+    wire cacheable = (cpu_address[31:30] == 2'b00);
+    wire allocate_on_write = WRITE_BACK && cacheable;
+
+    // Prefetch Target: line the prefetcher wants next, and the line being prefetched
+    reg [31:0] prefetch_address;
+    reg [3:0]  prefetch_count; // Prefetches left in the current burst of PREFETCH_DEGREE
+    reg        prefetch_active; // The refill FSM is filling a prefetch, not a demand miss
+    reg [27:0] prefetch_line;
+    wire [INDEX_BITS-1:0] prefetch_index = prefetch_address[INDEX_BITS+OFFSET_BITS-1 : OFFSET_BITS];
+    wire [TAG_BITS-1:0] prefetch_tag = prefetch_address[31 : 31-TAG_BITS+1];
+
+    // Refill Target: the latched demand line, or the latched prefetch line.
+    // The demand line is captured when the miss leaves IDLE, so the CPU may withdraw
+    // or change its access while the refill runs (a hardware thread switch squashes the load).
+    reg [27:0] demand_line;
+    wire [31:0] fill_address = prefetch_active ? {prefetch_line, 4'b0000} : {demand_line, 4'b0000};
+    wire [INDEX_BITS-1:0] fill_index = fill_address[INDEX_BITS+OFFSET_BITS-1 : OFFSET_BITS];
+    wire [TAG_BITS-1:0] fill_tag = fill_address[31 : 31-TAG_BITS+1];
+    wire fill_cacheable = prefetch_active || (demand_line[27:26] == 2'b00);
+
+    // Hit Detection (compare all ways in parallel)
+    wire [NUM_WAYS-1:0] way_hit;
+    wire [NUM_WAYS-1:0] way_valid;
+    wire [NUM_WAYS-1:0] prefetch_way_hit;
+    wire [NUM_WAYS-1:0] prefetch_way_valid;
+
+    genvar g;
+    generate
+        for (g = 0; g < NUM_WAYS; g = g + 1) begin : g_way
+            assign way_valid[g] = valid[g][index];
+            assign way_hit[g] = valid[g][index] && (tag_array[g][index] == tag);
+            assign prefetch_way_valid[g] = valid[g][prefetch_index];
+            assign prefetch_way_hit[g] = valid[g][prefetch_index] && (tag_array[g][prefetch_index] == prefetch_tag);
+        end
+    endgenerate
+
+    wire hit = |way_hit;
+
+    reg [WAY_BITS-1:0] hit_way;
+    integer w;
+    always @(*) begin
+        hit_way = 0;
+        for (w = 0; w < NUM_WAYS; w = w + 1) begin
+            if (way_hit[w]) hit_way = w[WAY_BITS-1:0];
+        end
+    end
+
+    // PLRU Helpers
+    function [WAY_BITS-1:0] plru_victim;
+        input [PLRU_BITS-1:0] tree;
+        integer level;
+        integer node;
+        begin
+            plru_victim = 0;
+            node = 0;
+            for (level = 0; level < PLRU_LEVELS; level = level + 1) begin
+                plru_victim = (plru_victim << 1) | tree[node];
+                node = 2 * node + 1 + tree[node];
+            end
+        end
+    endfunction
+
+    function [PLRU_BITS-1:0] plru_touch;
+        input [PLRU_BITS-1:0] tree;
+        input [WAY_BITS-1:0] way;
+        integer level;
+        integer node;
+        reg direction;
+        begin
+            plru_touch = tree;
+            node = 0;
+            for (level = 0; level < PLRU_LEVELS; level = level + 1) begin
+                direction = way[PLRU_LEVELS-1-level];
+                plru_touch[node] = ~direction; // Point away from the accessed way
+                node = 2 * node + 1 + direction;
+            end
+        end
+    endfunction
+
+    // Victim Selection: first invalid way, otherwise the PLRU way
+    reg [WAY_BITS-1:0] victim_way;
+    reg found_invalid;
+    integer v;
+    always @(*) begin
+        victim_way = plru_victim(plru_tree[index]);
+        found_invalid = 0;
+        for (v = 0; v < NUM_WAYS; v = v + 1) begin
+            if (!way_valid[v] && !found_invalid) begin
+                victim_way = v[WAY_BITS-1:0];
+                found_invalid = 1;
+            end
+        end
+    end
+
+    // Prefetch Victim: same choice for the prefetch target's set
+    reg [WAY_BITS-1:0] prefetch_victim_way;
+    reg prefetch_found_invalid;
+    integer pv;
+    always @(*) begin
+        prefetch_victim_way = plru_victim(plru_tree[prefetch_index]);
+        prefetch_found_invalid = 0;
+        for (pv = 0; pv < NUM_WAYS; pv = pv + 1) begin
+            if (!prefetch_way_valid[pv] && !prefetch_found_invalid) begin
+                prefetch_victim_way = pv[WAY_BITS-1:0];
+                prefetch_found_invalid = 1;
+            end
+        end
+    end
+
+    // Victim Line (written back before the refill if dirty)
+    wire victim_dirty = way_valid[victim_way] && dirty[victim_way][index];
+    wire [TAG_BITS-1:0] evict_tag = tag_array[refill_way][fill_index];
+    wire [127:0] evict_block = data_array[refill_way][fill_index];
 
     // Read Data Extraction
-    wire [127:0] block_data = data_array[index];
+    wire [127:0] block_data = data_array[hit_way][index];
     reg [31:0] hit_data;
 
     always @(*) begin
@@ -55,42 +189,167 @@ module l1_data_cache (
         endcase
     end
 
+    // Store Merge: the hit block with the enabled bytes of the store applied
+    reg [127:0] store_block;
+    integer b;
+    always @(*) begin
+        store_block = block_data;
+        for (b = 0; b < 4; b = b + 1) begin
+            if (cpu_byte_enable[b]) store_block[word_offset*32 + b*8 +: 8] = cpu_write_data[b*8 +: 8];
+        end
+    end
+
     // FSM State
-    localparam STATE_IDLE = 3'd0;
-    localparam STATE_FETCH_0 = 3'd1;
-    localparam STATE_FETCH_1 = 3'd2;
-    localparam STATE_FETCH_2 = 3'd3;
-    localparam STATE_FETCH_3 = 3'd4;
-    localparam STATE_UPDATE = 3'd5;
-    localparam STATE_WRITE  = 3'd6;
-    localparam STATE_ACCESS_DONE = 3'd7;
-
-    reg [2:0] state, next_state;
+    localparam STATE_IDLE = 4'd0;
+    localparam STATE_FETCH_0 = 4'd1;
+    localparam STATE_FETCH_1 = 4'd2;
+    localparam STATE_FETCH_2 = 4'd3;
+    localparam STATE_FETCH_3 = 4'd4;
+    localparam STATE_UPDATE = 4'd5;
+    localparam STATE_WRITE  = 4'd6;
+    localparam STATE_ACCESS_DONE = 4'd7;
+    localparam STATE_EVICT = 4'd8; // Write the dirty victim back, one word per beat
+
+    reg [3:0] state, next_state;
     reg [127:0] refill_buffer;
     reg [127:0] next_refill_buffer;
 
+    // A CPU access starts a refill (prefetches leave IDLE only without a CPU access)
+    assign demand_miss = (state == STATE_IDLE) && (cpu_read_enable || cpu_write_enable) &&
+                         ((next_state == STATE_FETCH_0) || (next_state == STATE_EVICT));
+
+    // Way chosen for replacement, latched when the miss is detected
+    reg [WAY_BITS-1:0] refill_way;
+    reg [WAY_BITS-1:0] next_refill_way;
+
+    // Word of the victim line being written back
+    reg [1:0] evict_word;
+    reg [1:0] next_evict_word;
+
+    // Stride Prefetcher
+    // A PC-indexed table remembers each load's last address and stride. When a load repeats
+    // its stride, PREFETCH_DEGREE lines starting PREFETCH_DISTANCE strides ahead are queued.
+    // Strides shorter than a line are treated as a sequential stream of lines.
+    reg                 stride_valid [0:PREFETCH_TABLE_ENTRIES-1];
+    reg [31:0]          stride_pc [0:PREFETCH_TABLE_ENTRIES-1];
+    reg [31:0]          stride_last_address [0:PREFETCH_TABLE_ENTRIES-1];
+    reg [31:0]          stride_value [0:PREFETCH_TABLE_ENTRIES-1];
+    reg [1:0]           stride_confidence [0:PREFETCH_TABLE_ENTRIES-1];
+
+    wire [TABLE_BITS-1:0] stride_index = cpu_program_counter[TABLE_BITS+1:2];
+    wire stride_match = stride_valid[stride_index] && (stride_pc[stride_index] == cpu_program_counter);
+    wire [31:0] stride_delta = cpu_address - stride_last_address[stride_index];
+    wire stride_confirmed = stride_match && (stride_delta != 0) && (stride_delta == stride_value[stride_index]);
+    wire stride_short = ($signed(stride_delta) > -16) && ($signed(stride_delta) < 16);
+    wire [31:0] prefetch_step_next = stride_short ? (stride_delta[31] ? 32'hFFFF_FFF0 : 32'd16) : stride_delta;
+    reg  [31:0] prefetch_step;
+
+    // Train on every completed cacheable load
+    wire stride_train = PREFETCH_ENABLE && cpu_read_enable && !stall_cpu && cacheable;
+
+    // Prefetches only use cycles with no CPU access. Targets outside main memory, already
+    // cached, or whose victim is dirty are dropped.
+    wire prefetch_slot = PREFETCH_ENABLE && (state == STATE_IDLE) && !cpu_read_enable && !cpu_write_enable &&
+                         (prefetch_count != 0);
+    wire prefetch_start = prefetch_slot && (prefetch_address[31:30] == 2'b00) && !(|prefetch_way_hit) &&
+                          !(prefetch_way_valid[prefetch_victim_way] && dirty[prefetch_victim_way][prefetch_index]);
+
+    // A CPU access that a prefetch fill cannot serve (anything but a read hit) abandons the
+    // burst instead of waiting behind it; an access to the line being prefetched waits for it.
+    wire prefetch_fetching = prefetch_active && (state >= STATE_FETCH_0) && (state <= STATE_FETCH_3);
+    wire prefetch_preempt = prefetch_fetching && (cpu_write_enable || (cpu_read_enable && !hit)) &&
+                            (cpu_address[31:4] != prefetch_line);
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            prefetch_address <= 0;
+            prefetch_step <= 0;
+            prefetch_count <= 0;
+            prefetch_active <= 0;
+            prefetch_line <= 0;
+        end else begin
+            if (stride_train && stride_confirmed) begin
+                prefetch_address <= cpu_address + prefetch_step_next * PREFETCH_DISTANCE;
+                prefetch_step <= prefetch_step_next;
+                prefetch_count <= PREFETCH_DEGREE;
+            end else if (prefetch_slot) begin
+                prefetch_address <= prefetch_address + prefetch_step;
+                prefetch_count <= prefetch_count - 1;
+            end
+
+            if (prefetch_start) begin
+                prefetch_active <= 1;
+                prefetch_line <= prefetch_address[31:4];
+            end else if (state == STATE_UPDATE || prefetch_preempt) begin
+                prefetch_active <= 0;
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (stride_train) begin
+            if (!stride_match) begin
+                stride_valid[stride_index] <= 1;
+                stride_pc[stride_index] <= cpu_program_counter;
+                stride_value[stride_index] <= 0;
+                stride_confidence[stride_index] <= 0;
+            end else if (stride_delta != 0) begin
+                if (stride_confirmed) begin
+                    if (stride_confidence[stride_index] != 2'd3) begin
+                        stride_confidence[stride_index] <= stride_confidence[stride_index] + 1;
+                    end
+                end else if (stride_confidence[stride_index] > 2'd1) begin
+                    stride_confidence[stride_index] <= stride_confidence[stride_index] - 1; // Keep a trained stride through one outlier
+                end else begin
+                    stride_value[stride_index] <= stride_delta;
+                    stride_confidence[stride_index] <= 0;
+                end
+            end
+            stride_last_address[stride_index] <= cpu_address;
+        end
+    end
+
     // State Register
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             state <= STATE_IDLE;
             refill_buffer <= 0;
+            refill_way <= 0;
+            evict_word <= 0;
+            demand_line <= 0;
         end else begin
             state <= next_state;
+            if (state == STATE_IDLE) demand_line <= cpu_address[31:4];
             refill_buffer <= next_refill_buffer;
+            refill_way <= next_refill_way;
+            evict_word <= next_evict_word;
+`ifdef DEBUG_LOG // Per-access trace (verilate with +define+DEBUG_LOG)
             if (cpu_read_enable || cpu_write_enable || state != STATE_IDLE) begin
                  $display("%m: state=%d, addr=%h, we=%b, re=%b, hit=%b, mem_ready=%b, mem_rdata=%h, cpu_rdata=%h", 
                           state, cpu_address, cpu_write_enable, cpu_read_enable, hit, mem_ready, mem_read_data, cpu_read_data);
             end
+`endif
         end
     end
 
     // Initialization for simulation
-    integer i;
+    integer i, j;
     initial begin
         for (i = 0; i < NUM_SETS; i = i + 1) begin
-            valid[i] = 0;
-            tag_array[i] = 0;
-            data_array[i] = 0;
+            for (j = 0; j < NUM_WAYS; j = j + 1) begin
+                valid[j][i] = 0;
+                tag_array[j][i] = 0;
+                data_array[j][i] = 0;
+                dirty[j][i] = 0;
+            end
+            plru_tree[i] = 0;
+        end
+        for (i = 0; i < PREFETCH_TABLE_ENTRIES; i = i + 1) begin
+            stride_valid[i] = 0;
+            stride_pc[i] = 0;
+            stride_last_address[i] = 0;
+            stride_value[i] = 0;
+            stride_confidence[i] = 0;
         end
     end
 
@@ -98,11 +357,15 @@ module l1_data_cache (
     always @(*) begin
         next_state = state;
         next_refill_buffer = refill_buffer;
+        next_refill_way = refill_way;
+        next_evict_word = evict_word;
         
         stall_cpu = 0;
         cpu_read_data = 0;
         
         mem_request = 0;
+        mem_burst = 0;
+        mem_abort = 0;
         mem_address = 0;
         mem_write_data = 0;
         mem_byte_enable = 0;
@@ -116,19 +379,51 @@ module l1_data_cache (
                         cpu_read_data = hit_data;
                     end else begin
                         stall_cpu = 1; // Stall!
-                        next_state = STATE_FETCH_0;
+                        next_refill_way = victim_way;
+                        next_evict_word = 0;
+                        next_state = victim_dirty ? STATE_EVICT : STATE_FETCH_0;
                     end
                 end else if (cpu_write_enable) begin
-                    stall_cpu = 1; // Stall for write-through
-                    next_state = STATE_WRITE;
+                    if (allocate_on_write) begin
+                        if (hit) begin
+                            stall_cpu = 0; // Store hit completes this cycle, line marked dirty
+                        end else begin
+                            stall_cpu = 1; // Allocate the line, the store then hits
+                            next_refill_way = victim_way;
+                            next_evict_word = 0;
+                            next_state = victim_dirty ? STATE_EVICT : STATE_FETCH_0;
+                        end
+                    end else begin
+                        stall_cpu = 1; // Stall for write-through
+                        next_state = STATE_WRITE;
+                    end
+                end else if (prefetch_start) begin
+                    next_refill_way = prefetch_victim_way;
+                    next_state = STATE_FETCH_0;
+                end
+            end
+
+            STATE_EVICT: begin
+                stall_cpu = 1;
+                mem_request = 1;
+                mem_write_enable = 1;
+                mem_byte_enable = 4'b1111;
+                mem_address = {evict_tag, fill_index, evict_word, 2'b00};
+                mem_write_data = evict_block[evict_word*32 +: 32];
+                if (mem_ready) begin
+                    next_evict_word = evict_word + 1;
+                    if (evict_word == 2'd3) begin
+                        next_state = STATE_FETCH_0;
+                    end
                 end
             end
 
             STATE_FETCH_0: begin
                 stall_cpu = 1;
                 mem_request = 1;
+                mem_burst = fill_cacheable;
                 mem_write_enable = 0;
-                mem_address = {cpu_address[31:4], 4'b0000}; // Word 0
+                mem_address = {fill_address[31:4], 4'b0000}; // Word 0
                 if (mem_ready) begin
                     next_refill_buffer[31:0] = mem_read_data;
                     next_state = STATE_FETCH_1;
@@ -138,8 +433,9 @@ module l1_data_cache (
             STATE_FETCH_1: begin
                 stall_cpu = 1;
                 mem_request = 1;
+                mem_burst = fill_cacheable;
                 mem_write_enable = 0;
-                mem_address = {cpu_address[31:4], 4'b0100}; // Word 1
+                mem_address = {fill_address[31:4], fill_cacheable ? 4'b0000 : 4'b0100}; // Word 1
                 if (mem_ready) begin
                     next_refill_buffer[63:32] = mem_read_data;
                     next_state = STATE_FETCH_2;
@@ -149,8 +445,9 @@ module l1_data_cache (
             STATE_FETCH_2: begin
                 stall_cpu = 1;
                 mem_request = 1;
+                mem_burst = fill_cacheable;
                 mem_write_enable = 0;
-                mem_address = {cpu_address[31:4], 4'b1000}; // Word 2
+                mem_address = {fill_address[31:4], fill_cacheable ? 4'b0000 : 4'b1000}; // Word 2
                 if (mem_ready) begin
                     next_refill_buffer[95:64] = mem_read_data;
                     next_state = STATE_FETCH_3;
@@ -160,8 +457,9 @@ module l1_data_cache (
             STATE_FETCH_3: begin
                 stall_cpu = 1;
                 mem_request = 1;
+                mem_burst = fill_cacheable;
                 mem_write_enable = 0;
-                mem_address = {cpu_address[31:4], 4'b1100}; // Word 3
+                mem_address = {fill_address[31:4], fill_cacheable ? 4'b0000 : 4'b1100}; // Word 3
                 if (mem_ready) begin
                     next_refill_buffer[127:96] = mem_read_data;
                     next_state = STATE_UPDATE;
@@ -191,45 +489,48 @@ module l1_data_cache (
                 next_state = STATE_IDLE;
             end
         endcase
+
+        // While the refill FSM fills a prefetch, read hits are still served and the CPU is
+        // only stalled by an access; one that needs the FSM ends the burst and starts from IDLE
+        if (prefetch_active) begin
+            if (prefetch_preempt) begin
+                stall_cpu = 1;
+                mem_request = 0;
+                mem_burst = 0;
+                mem_address = 0;
+                mem_abort = 1;
+                next_state = STATE_IDLE;
+            end else if (cpu_read_enable && hit) begin
+                stall_cpu = 0;
+                cpu_read_data = hit_data;
+            end else if (!cpu_read_enable && !cpu_write_enable) begin
+                stall_cpu = 0;
+            end
+        end
     end
 
     // Cache Update Logic (Synchronous)
     always @(posedge clk) begin
         if (state == STATE_UPDATE) begin
-            valid[index] <= 1;
-            tag_array[index] <= tag;
-            data_array[index] <= refill_buffer;
+            valid[refill_way][fill_index] <= 1;
+            tag_array[refill_way][fill_index] <= fill_tag;
+            data_array[refill_way][fill_index] <= refill_buffer;
+            dirty[refill_way][fill_index] <= 0;
+            plru_tree[fill_index] <= plru_touch(plru_tree[fill_index], refill_way);
+        end else if (state == STATE_IDLE && cpu_write_enable && allocate_on_write && hit) begin
+            // Write-Back: update the line only, memory sees it on eviction
+            data_array[hit_way][index] <= store_block;
+            dirty[hit_way][index] <= 1;
+            plru_tree[index] <= plru_touch(plru_tree[index], hit_way);
         end else if (state == STATE_WRITE && mem_ready) begin
             // Write-Through: If it was a hit, we must update the cache too!
             // If it was a miss, we don't allocate (No-Write-Allocate), so we don't touch cache.
             if (hit) begin
-                case (word_offset)
-                    2'b00: begin
-                        if (cpu_byte_enable[0]) data_array[index][7:0]   <= cpu_write_data[7:0];
-                        if (cpu_byte_enable[1]) data_array[index][15:8]  <= cpu_write_data[15:8];
-                        if (cpu_byte_enable[2]) data_array[index][23:16] <= cpu_write_data[23:16];
-                        if (cpu_byte_enable[3]) data_array[index][31:24] <= cpu_write_data[31:24];
-                    end
-                    2'b01: begin
-                        if (cpu_byte_enable[0]) data_array[index][39:32] <= cpu_write_data[7:0];
-                        if (cpu_byte_enable[1]) data_array[index][47:40] <= cpu_write_data[15:8];
-                        if (cpu_byte_enable[2]) data_array[index][55:48] <= cpu_write_data[23:16];
-                        if (cpu_byte_enable[3]) data_array[index][63:56] <= cpu_write_data[31:24];
-                    end
-                    2'b10: begin
-                        if (cpu_byte_enable[0]) data_array[index][71:64] <= cpu_write_data[7:0];
-                        if (cpu_byte_enable[1]) data_array[index][79:72] <= cpu_write_data[15:8];
-                        if (cpu_byte_enable[2]) data_array[index][87:80] <= cpu_write_data[23:16];
-                        if (cpu_byte_enable[3]) data_array[index][95:88] <= cpu_write_data[31:24];
-                    end
-                    2'b11: begin
-                        if (cpu_byte_enable[0]) data_array[index][103:96]  <= cpu_write_data[7:0];
-                        if (cpu_byte_enable[1]) data_array[index][111:104] <= cpu_write_data[15:8];
-                        if (cpu_byte_enable[2]) data_array[index][119:112] <= cpu_write_data[23:16];
-                        if (cpu_byte_enable[3]) data_array[index][127:120] <= cpu_write_data[31:24];
-                    end
-                endcase
+                data_array[hit_way][index] <= store_block;
+                plru_tree[index] <= plru_touch(plru_tree[index], hit_way);
             end
+        end else if (state == STATE_IDLE && cpu_read_enable && hit) begin
+            plru_tree[index] <= plru_touch(plru_tree[index], hit_way);
         end
     end
 
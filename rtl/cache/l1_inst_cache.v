@@ -7,12 +7,20 @@ module l1_inst_cache (
     input wire [31:0] program_counter_address,
     output reg [31:0] instruction,
     output reg stall_cpu, // 1 if miss (stall CPU), 0 if hit
+    output reg [31:0] second_instruction, // Dual fetch: the word after the PC, on a hit
+    output reg second_instruction_valid,  // That word is in the same line
 
     // Memory Interface (32-bit)
     output reg [31:0] instruction_memory_address,
     output reg instruction_memory_request,
+    output reg instruction_memory_burst, // Line fill as one 4-beat burst
+    output reg instruction_memory_prefetch, // Request is a speculative next-line prefetch
+    output reg instruction_memory_abort, // The prefetch burst in flight is abandoned this cycle
+    input wire instruction_memory_preempted, // The arbiter dropped the prefetch burst for the D-Cache
     input wire [31:0] instruction_memory_read_data,
-    input wire instruction_memory_ready
+    input wire instruction_memory_ready,
+
+    output wire demand_miss // A fetch miss starts a refill this cycle (performance counters)
 );
 
     // Parameters
@@ -20,6 +28,7 @@ module l1_inst_cache (
     parameter INDEX_BITS = 8; // log2(256)
     parameter OFFSET_BITS = 4; // 16 bytes
     parameter TAG_BITS = 32 - INDEX_BITS - OFFSET_BITS; // 20 bits
+    parameter PREFETCH_ENABLE = 0; // Next-line prefetch into a one-entry stream buffer
 
     // Cache Storage
     reg valid [0:NUM_SETS-1];
@@ -49,6 +58,10 @@ module l1_inst_cache (
         endcase
     end
 
+    // Dual fetch: the next word of the hit line
+    wire [1:0] second_word_offset = active_word_offset + 2'd1;
+    wire [31:0] second_word_data = block_data[second_word_offset*32 +: 32];
+
     // FSM State
     localparam STATE_IDLE = 3'd0;
     localparam STATE_FETCH_0 = 3'd1;
@@ -60,6 +73,8 @@ module l1_inst_cache (
     reg [2:0] state, next_state;
     reg [127:0] refill_buffer;
     reg [127:0] next_refill_buffer;
+
+    assign demand_miss = (state == STATE_IDLE) && (next_state == STATE_FETCH_0);
     
     // Latch the PC address during a miss to maintain consistent index/tag during fill
     reg [31:0] miss_address;
@@ -71,16 +86,105 @@ module l1_inst_cache (
     wire [TAG_BITS-1:0] active_tag = active_address[31 : 31-TAG_BITS+1];
     wire [1:0] active_word_offset = active_address[3:2];
 
+    // Critical-word-first refill: the burst starts at the missing word and wraps around the line
+    wire [2:0] fill_state = state - STATE_FETCH_0;
+    wire [1:0] fill_beat = fill_state[1:0]; // FETCH_0..3 -> beat 0..3
+    wire [1:0] fill_word = miss_address[3:2] + fill_beat;
+    wire fill_arriving = (state != STATE_IDLE) && (state != STATE_UPDATE) && instruction_memory_ready;
+
+    // Words of the line being filled that have already arrived
+    reg [3:0] refill_valid;
+    reg [3:0] next_refill_valid;
+
+    // Early restart: the PC's word can be served from the refill while the rest streams in
+    wire pc_in_fill_line = (program_counter_address[31:4] == miss_address[31:4]);
+    wire [1:0] pc_word = program_counter_address[3:2];
+    wire pc_word_arriving = fill_arriving && (fill_word == pc_word);
+    wire early_restart = pc_in_fill_line && (refill_valid[pc_word] || pc_word_arriving);
+    wire [31:0] early_restart_data = pc_word_arriving ? instruction_memory_read_data : refill_buffer[pc_word*32 +: 32];
+
+    // Next-Line Prefetch: while line N hits, line N+1 is fetched into the stream buffer
+    // using cycles in which the memory port would otherwise be idle
+    reg prefetch_busy;           // Prefetch burst in flight
+    reg [1:0] prefetch_beat;
+    reg [27:0] prefetch_line;    // Line address being prefetched
+    reg stream_valid;
+    reg [27:0] stream_line;
+    reg [127:0] stream_data;
+
+    // Prefetch statistics: promoted into the cache vs. dropped unused vs. abandoned mid-burst
+    reg [31:0] prefetch_useful;
+    reg [31:0] prefetch_useless;
+    reg [31:0] prefetch_aborted;
+
+    wire [27:0] pc_line = program_counter_address[31:4];
+    wire [27:0] next_line = pc_line + 1;
+    wire [INDEX_BITS-1:0] next_line_index = next_line[INDEX_BITS-1:0];
+    wire next_line_cached = valid[next_line_index] && (tag_array[next_line_index] == next_line[27:INDEX_BITS]);
+
+    // Only main memory (below 0x4000_0000) is prefetched
+    wire prefetch_start = PREFETCH_ENABLE && (state == STATE_IDLE) && hit && !prefetch_busy &&
+                          !next_line_cached && (next_line[27:26] == 2'b00) &&
+                          !(stream_valid && stream_line == next_line);
+
+    // A miss that hits the stream buffer is served from it and promoted into the cache
+    wire stream_hit = stream_valid && (stream_line == pc_line);
+
+    // A demand miss to another line abandons the prefetch in flight instead of waiting behind
+    // it; a miss on the line being prefetched waits for it. Either way of ending the burst
+    // early (this or the arbiter's preemption) drops the partial line.
+    wire prefetch_preempt = prefetch_busy && (state == STATE_IDLE) && !hit && !stream_hit &&
+                            (pc_line != prefetch_line);
+    wire prefetch_cancel = prefetch_busy && (prefetch_preempt || instruction_memory_preempted);
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            prefetch_busy <= 0;
+            prefetch_beat <= 0;
+            prefetch_line <= 0;
+            stream_valid <= 0;
+            stream_line <= 0;
+            stream_data <= 0;
+            prefetch_useful <= 0;
+            prefetch_useless <= 0;
+            prefetch_aborted <= 0;
+        end else begin
+            if (prefetch_cancel) begin
+                prefetch_busy <= 0;
+                prefetch_aborted <= prefetch_aborted + 1;
+            end else if (prefetch_start) begin
+                if (stream_valid) prefetch_useless <= prefetch_useless + 1;
+                prefetch_busy <= 1;
+                prefetch_beat <= 0;
+                prefetch_line <= next_line;
+                stream_valid <= 0;
+            end else if (prefetch_busy && instruction_memory_ready) begin
+                stream_data[prefetch_beat*32 +: 32] <= instruction_memory_read_data;
+                prefetch_beat <= prefetch_beat + 1;
+                if (prefetch_beat == 2'd3) begin
+                    prefetch_busy <= 0;
+                    stream_valid <= 1;
+                    stream_line <= prefetch_line;
+                end
+            end else if (state == STATE_IDLE && !hit && stream_hit) begin
+                prefetch_useful <= prefetch_useful + 1;
+                stream_valid <= 0;
+            end
+        end
+    end
+
     // State Register
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             state <= STATE_IDLE;
             refill_buffer <= 0;
             miss_address <= 0;
+            refill_valid <= 0;
         end else begin
             state <= next_state;
             refill_buffer <= next_refill_buffer;
             miss_address <= next_miss_address;
+            refill_valid <= next_refill_valid;
         end
     end
 
@@ -99,10 +203,16 @@ module l1_inst_cache (
         next_state = state;
         next_refill_buffer = refill_buffer;
         next_miss_address = miss_address;
+        next_refill_valid = refill_valid;
         
         stall_cpu = 0;
         instruction = 0;
+        second_instruction = 0;
+        second_instruction_valid = 0;
         instruction_memory_request = 0;
+        instruction_memory_burst = 0;
+        instruction_memory_prefetch = 0;
+        instruction_memory_abort = 0;
         instruction_memory_address = 0;
 
         case (state)
@@ -110,55 +220,54 @@ module l1_inst_cache (
                 if (hit) begin
                     stall_cpu = 0;
                     instruction = hit_data;
+                    second_instruction = second_word_data;
+                    second_instruction_valid = (word_offset != 2'b11);
+                end else if (stream_hit) begin
+                    // Served straight from the stream buffer, installed through UPDATE
+                    stall_cpu = 0;
+                    instruction = stream_data[word_offset*32 +: 32];
+                    next_miss_address = program_counter_address;
+                    next_refill_buffer = stream_data;
+                    next_refill_valid = 4'b1111;
+                    next_state = STATE_UPDATE;
+                end else if (prefetch_busy && !prefetch_cancel) begin
+                    // The prefetch in flight brings this line; retry once it completes
+                    stall_cpu = 1;
                 end else begin
                     stall_cpu = 1; // Stall!
                     next_miss_address = program_counter_address; // Latch the miss address
+                    next_refill_valid = 0;
                     next_state = STATE_FETCH_0;
                 end
-            end
-
-            STATE_FETCH_0: begin
-                stall_cpu = 1;
-                instruction_memory_request = 1;
-                instruction_memory_address = {active_address[31:4], 4'b0000}; // Word 0
-                if (instruction_memory_ready) begin
-                    next_refill_buffer[31:0] = instruction_memory_read_data;
-                    next_state = STATE_FETCH_1;
-                end
-            end
 
-            STATE_FETCH_1: begin
-                stall_cpu = 1;
-                instruction_memory_request = 1;
-                instruction_memory_address = {active_address[31:4], 4'b0100}; // Word 1
-                if (instruction_memory_ready) begin
-                    next_refill_buffer[63:32] = instruction_memory_read_data;
-                    next_state = STATE_FETCH_2;
+                // Prefetch burst (never overlaps a demand refill)
+                if (prefetch_preempt) begin
+                    instruction_memory_abort = 1;
+                end else if (prefetch_busy) begin
+                    instruction_memory_request = 1;
+                    instruction_memory_burst = 1;
+                    instruction_memory_prefetch = 1;
+                    instruction_memory_address = {prefetch_line, 4'b0000};
                 end
             end
 
-            STATE_FETCH_2: begin
-                stall_cpu = 1;
+            // One wrapping burst from the missing word; each beat fills word (miss word + beat)
+            STATE_FETCH_0, STATE_FETCH_1, STATE_FETCH_2, STATE_FETCH_3: begin
+                stall_cpu = !early_restart;
+                instruction = early_restart ? early_restart_data : 0;
                 instruction_memory_request = 1;
-                instruction_memory_address = {active_address[31:4], 4'b1000}; // Word 2
+                instruction_memory_burst = 1;
+                instruction_memory_address = {miss_address[31:2], 2'b00};
                 if (instruction_memory_ready) begin
-                    next_refill_buffer[95:64] = instruction_memory_read_data;
-                    next_state = STATE_FETCH_3;
-                end
-            end
-
-            STATE_FETCH_3: begin
-                stall_cpu = 1;
-                instruction_memory_request = 1;
-                instruction_memory_address = {active_address[31:4], 4'b1100}; // Word 3
-                if (instruction_memory_ready) begin
-                    next_refill_buffer[127:96] = instruction_memory_read_data;
-                    next_state = STATE_UPDATE;
+                    next_refill_buffer[fill_word*32 +: 32] = instruction_memory_read_data;
+                    next_refill_valid[fill_word] = 1;
+                    next_state = (state == STATE_FETCH_3) ? STATE_UPDATE : state + 1;
                 end
             end
 
             STATE_UPDATE: begin
-                stall_cpu = 1;
+                stall_cpu = !early_restart;
+                instruction = early_restart ? early_restart_data : 0;
                 next_state = STATE_IDLE;
             end
         endcase
@@ -10,6 +10,8 @@ module l2_cache (
     input wire [3:0]  s_be,
     input wire        s_we,
     input wire        s_en,
+    input wire        s_burst, // 4-beat wrapping read burst starting at s_addr
+    input wire        s_abort, // The requester ends its burst early; a new request may come with it
     output reg [31:0] s_rdata,
     output reg        s_ready,
 
@@ -19,8 +21,11 @@ module l2_cache (
     output reg [3:0]  mem_be,
     output reg        mem_we,
     output reg        mem_req,
+    output reg        mem_burst,
     input wire [31:0] mem_rdata,
-    input wire        mem_ready
+    input wire        mem_ready,
+
+    output wire       demand_miss // A read miss starts a line fill this cycle (performance counters)
 );
 
     // Parameters
@@ -65,19 +70,51 @@ module l2_cache (
     localparam STATE_FETCH_3 = 3'd4;
     localparam STATE_UPDATE = 3'd5;
     localparam STATE_WRITE  = 3'd6;
+    localparam STATE_BURST  = 3'd7;
 
     reg [2:0] state, next_state;
     reg [127:0] refill_buffer;
     reg [127:0] next_refill_buffer;
 
+    // Aborted bursts: a hit burst stops at once and the cycle is handled as IDLE. A fill from
+    // memory cannot be stopped; it completes into the cache without forwarding beats.
+    wire [2:0] serve_state = (s_abort && state == STATE_BURST) ? STATE_IDLE : state;
+    reg        fill_forward; // The fill's requester takes the beats as they arrive
+
+    assign demand_miss = (serve_state == STATE_IDLE) && (next_state == STATE_FETCH_0);
+
+    // Latch the miss address: the line is filled in wrap order from the missing word
+    reg [31:0] miss_address;
+    reg [31:0] next_miss_address;
+    wire [INDEX_BITS-1:0] fill_index = miss_address[INDEX_BITS+OFFSET_BITS-1 : OFFSET_BITS];
+    wire [TAG_BITS-1:0] fill_tag = miss_address[31 : 31-TAG_BITS+1];
+    wire [2:0] fill_state = state - STATE_FETCH_0;
+    wire [1:0] fill_beat = fill_state[1:0]; // FETCH_0..3 -> beat 0..3
+    wire [1:0] fill_word = miss_address[3:2] + fill_beat;
+
+    // Burst read hit: one beat per cycle in wrap order from s_addr
+    reg [1:0] burst_beat;
+    reg [1:0] next_burst_beat;
+    wire [1:0] burst_word = word_offset + burst_beat;
+
     // State Register
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             state <= STATE_IDLE;
             refill_buffer <= 0;
+            miss_address <= 0;
+            burst_beat <= 0;
+            fill_forward <= 0;
         end else begin
             state <= next_state;
             refill_buffer <= next_refill_buffer;
+            miss_address <= next_miss_address;
+            burst_beat <= next_burst_beat;
+            if (demand_miss) begin
+                fill_forward <= s_burst;
+            end else if (s_abort) begin
+                fill_forward <= 0;
+            end
         end
     end
 
@@ -93,26 +130,33 @@ module l2_cache (
 
     // Next State Logic
     always @(*) begin
-        next_state = state;
+        next_state = serve_state;
         next_refill_buffer = refill_buffer;
+        next_miss_address = miss_address;
+        next_burst_beat = burst_beat;
         
         s_ready = 0;
         s_rdata = 0;
         
         mem_req = 0;
+        mem_burst = 0;
         mem_addr = 0;
         mem_wdata = 0;
         mem_be = 0;
         mem_we = 0;
 
-        case (state)
+        case (serve_state)
             STATE_IDLE: begin
                 if (s_en && !s_we) begin // Read
-                    if (hit) begin
+                    if (hit && s_burst) begin
+                        next_burst_beat = 0;
+                        next_state = STATE_BURST;
+                    end else if (hit) begin
                         s_ready = 1;
                         s_rdata = hit_data;
                     end else begin
                         s_ready = 0; // Stall
+                        next_miss_address = s_addr;
                         next_state = STATE_FETCH_0;
                     end
                 end else if (s_en && s_we) begin // Write
@@ -121,43 +165,20 @@ module l2_cache (
                 end
             end
 
-            STATE_FETCH_0: begin
-                mem_req = 1;
-                mem_we = 0;
-                mem_addr = {s_addr[31:4], 4'b0000}; // Word 0
-                if (mem_ready) begin
-                    next_refill_buffer[31:0] = mem_rdata;
-                    next_state = STATE_FETCH_1;
-                end
-            end
-
-            STATE_FETCH_1: begin
-                mem_req = 1;
-                mem_we = 0;
-                mem_addr = {s_addr[31:4], 4'b0100}; // Word 1
-                if (mem_ready) begin
-                    next_refill_buffer[63:32] = mem_rdata;
-                    next_state = STATE_FETCH_2;
-                end
-            end
-
-            STATE_FETCH_2: begin
+            // Line fill: one memory burst, beats arrive in wrap order from the missing word.
+            // A burst requester gets each beat forwarded as it arrives, unless it aborted.
+            STATE_FETCH_0, STATE_FETCH_1, STATE_FETCH_2, STATE_FETCH_3: begin
                 mem_req = 1;
+                mem_burst = 1;
                 mem_we = 0;
-                mem_addr = {s_addr[31:4], 4'b1000}; // Word 2
+                mem_addr = {miss_address[31:2], 2'b00};
                 if (mem_ready) begin
-                    next_refill_buffer[95:64] = mem_rdata;
-                    next_state = STATE_FETCH_3;
-                end
-            end
-
-            STATE_FETCH_3: begin
-                mem_req = 1;
-                mem_we = 0;
-                mem_addr = {s_addr[31:4], 4'b1100}; // Word 3
-                if (mem_ready) begin
-                    next_refill_buffer[127:96] = mem_rdata;
-                    next_state = STATE_UPDATE;
+                    next_refill_buffer[fill_word*32 +: 32] = mem_rdata;
+                    next_state = (state == STATE_FETCH_3) ? STATE_UPDATE : state + 1;
+                    if (fill_forward && !s_abort) begin
+                        s_ready = 1;
+                        s_rdata = mem_rdata;
+                    end
                 end
             end
 
@@ -166,6 +187,15 @@ module l2_cache (
                 next_state = STATE_IDLE;
             end
 
+            STATE_BURST: begin
+                s_ready = 1;
+                s_rdata = block_data[burst_word*32 +: 32];
+                next_burst_beat = burst_beat + 1;
+                if (burst_beat == 2'd3) begin
+                    next_state = STATE_IDLE;
+                end
+            end
+
             STATE_WRITE: begin
                 // Write-through to memory
                 mem_req = 1;
@@ -185,9 +215,9 @@ module l2_cache (
     // Cache Update Logic (Sequential)
     always @(posedge clk) begin
         if (state == STATE_UPDATE) begin
-            valid[index] <= 1;
-            tag_array[index] <= tag;
-            data_array[index] <= refill_buffer;
+            valid[fill_index] <= 1;
+            tag_array[fill_index] <= fill_tag;
+            data_array[fill_index] <= refill_buffer;
         end else if (state == STATE_WRITE && mem_ready) begin
             // Update cache on write hit (Write-Update / Write-Through)
             if (hit) begin
@@ -0,0 +1,174 @@
+module store_buffer (
+    input wire clk,
+    input wire rst_n,
+
+    // CPU Interface (same protocol as the L1 data cache CPU port)
+    input wire [31:0] cpu_address,
+    input wire [31:0] cpu_write_data,
+    input wire [3:0]  cpu_byte_enable,
+    input wire        cpu_write_enable,
+    input wire        cpu_read_enable,
+    output reg [31:0] cpu_read_data,
+    output reg        stall_cpu,
+
+    // Cache Interface (to L1 Data Cache CPU port)
+    output reg [31:0] cache_address,
+    output reg [31:0] cache_write_data,
+    output reg [3:0]  cache_byte_enable,
+    output reg        cache_write_enable,
+    output reg        cache_read_enable,
+    input wire [31:0] cache_read_data,
+    input wire        cache_stall
+);
+
+    // Posted store FIFO: stores retire from the pipeline in one cycle and
+    // drain into the data cache in the background, oldest first.
+
+    // Parameters
+    parameter DEPTH = 4; // Number of entries (power of two)
+
+    localparam PTR_BITS = (DEPTH > 1) ? $clog2(DEPTH) : 1;
+
+    // Entry Storage
+    reg [31:0] entry_address [0:DEPTH-1];
+    reg [31:0] entry_data [0:DEPTH-1];
+    reg [3:0]  entry_byte_enable [0:DEPTH-1];
+
+    reg [PTR_BITS-1:0] head; // Oldest entry (next to drain)
+    reg [PTR_BITS-1:0] tail; // Next free slot
+    reg [PTR_BITS:0]   count;
+
+    wire empty = (count == 0);
+    wire full = (count == DEPTH);
+
+    // A drain that the cache has started must be presented until it completes
+    reg drain_active;
+
+    // Peripheral space (0x4000_0000 and up): loads there wait for all older stores
+    wire cacheable = (cpu_address[31:30] == 2'b00);
+
+    // -------------------------------------------------------------------------
+    // Store-to-Load Forwarding
+    // -------------------------------------------------------------------------
+    // Merge every pending store to the load's word, oldest to youngest
+    reg [31:0] forward_data;
+    reg [3:0]  forward_mask;
+    reg [PTR_BITS-1:0] slot;
+    integer k;
+    integer b;
+
+    always @(*) begin
+        forward_data = 0;
+        forward_mask = 0;
+        slot = 0;
+        for (k = 0; k < DEPTH; k = k + 1) begin
+            slot = head + k[PTR_BITS-1:0];
+            if (k < count && entry_address[slot][31:2] == cpu_address[31:2]) begin
+                for (b = 0; b < 4; b = b + 1) begin
+                    if (entry_byte_enable[slot][b]) begin
+                        forward_data[b*8 +: 8] = entry_data[slot][b*8 +: 8];
+                        forward_mask[b] = 1;
+                    end
+                end
+            end
+        end
+    end
+
+    // Load served entirely from the buffer; a peripheral load must reach the device instead
+    wire forward_full = (forward_mask == 4'b1111) && cacheable;
+
+    // Cache data with the bytes of pending stores laid on top
+    reg [31:0] merged_read_data;
+    integer m;
+
+    always @(*) begin
+        for (m = 0; m < 4; m = m + 1) begin
+            merged_read_data[m*8 +: 8] = forward_mask[m] ? forward_data[m*8 +: 8] : cache_read_data[m*8 +: 8];
+        end
+    end
+
+    // -------------------------------------------------------------------------
+    // Cache Port Arbitration
+    // -------------------------------------------------------------------------
+    // Priority: Drain in progress > Load > Start drain
+    wire load_wait = cpu_read_enable && !cacheable && !empty;
+    wire issue_load = !drain_active && cpu_read_enable && !forward_full && !load_wait;
+    wire issue_drain = !empty && !issue_load;
+
+    wire drain_done = issue_drain && !cache_stall;
+    wire enqueue = cpu_write_enable && !full;
+
+    always @(*) begin
+        cache_address = 0;
+        cache_write_data = 0;
+        cache_byte_enable = 0;
+        cache_write_enable = 0;
+        cache_read_enable = 0;
+
+        if (issue_load) begin
+            cache_address = cpu_address;
+            cache_read_enable = 1;
+        end else if (issue_drain) begin
+            cache_address = entry_address[head];
+            cache_write_data = entry_data[head];
+            cache_byte_enable = entry_byte_enable[head];
+            cache_write_enable = 1;
+        end
+    end
+
+    // CPU Response
+    always @(*) begin
+        stall_cpu = 0;
+        cpu_read_data = 0;
+
+        if (cpu_read_enable) begin
+            if (forward_full) begin
+                cpu_read_data = forward_data;
+            end else if (issue_load) begin
+                stall_cpu = cache_stall;
+                cpu_read_data = merged_read_data;
+            end else begin
+                stall_cpu = 1; // Wait for the drain to finish
+            end
+        end else if (cpu_write_enable) begin
+            stall_cpu = full;
+        end
+    end
+
+    // -------------------------------------------------------------------------
+    // FIFO Update
+    // -------------------------------------------------------------------------
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            head <= 0;
+            tail <= 0;
+            count <= 0;
+            drain_active <= 0;
+        end else begin
+            if (enqueue) begin
+                entry_address[tail] <= cpu_address;
+                entry_data[tail] <= cpu_write_data;
+                entry_byte_enable[tail] <= cpu_byte_enable;
+                tail <= tail + 1;
+            end
+
+            if (drain_done) begin
+                head <= head + 1;
+            end
+
+            count <= count + (enqueue ? 1 : 0) - (drain_done ? 1 : 0);
+            drain_active <= issue_drain && cache_stall;
+        end
+    end
+
+    // Initialization for simulation
+    integer i;
+    initial begin
+        for (i = 0; i < DEPTH; i = i + 1) begin
+            entry_address[i] = 0;
+            entry_data[i] = 0;
+            entry_byte_enable[i] = 0;
+        end
+    end
+
+endmodule
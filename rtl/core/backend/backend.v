@@ -5,12 +5,17 @@ module backend (
 
     // Inputs from Frontend (IF/ID Pipeline Register)
     input wire [31:0] if_id_program_counter,
-    input wire [31:0] if_id_instruction,
+    input wire [31:0] if_id_instruction /*verilator public_flat_rd*/,
     input wire if_id_prediction_taken,
     input wire [31:0] if_id_prediction_target,
+    input wire [31:0] if_id_prediction_history, // Global history the prediction was made with
 
-    // I-Cache Status (for stalling)
-    input wire instruction_grant,
+    // Second issue slot (dual issue): the fetch queue entry behind the ID instruction
+    input wire [31:0] if_id_second_program_counter,
+    input wire [31:0] if_id_second_instruction,
+    input wire if_id_second_prediction_taken,
+    input wire if_id_second_valid,
+    output wire issue_second, // The second instruction enters EX alongside the first
 
     // Bus Interface
     output wire [31:0] bus_address,
@@ -18,29 +23,46 @@ module backend (
     output wire [3:0]  bus_byte_enable,
     output wire        bus_write_enable,
     output wire        bus_read_enable,
+    output wire [31:0] bus_program_counter, // PC of the MEM-stage access (prefetch training)
     input  wire [31:0] bus_read_data,
     input  wire        bus_busy,
     input  wire        timer_interrupt_request, // Added input
+    input  wire [2:0]  cache_miss_events, // Demand misses this cycle: {L2, D-Cache, I-Cache} (performance counters)
 
     // Outputs to Frontend (Control / Feedback)
     output wire stall_pipeline, // To Frontend
     output wire flush_due_to_branch,
-    output wire flush_due_to_jump,
+    output wire flush_due_to_jump,  // JAL in ID redirects the fetch (correct_pc)
     output wire flush_due_to_trap,
     output wire [31:0] correct_pc,
     output wire [31:0] trap_pc,
     output wire pc_mux_select_trap,
 
     // Outputs to Frontend (BP Update)
-    output reg [31:0] id_ex_program_counter,
+    output reg [31:0] id_ex_program_counter /*verilator public_flat_rd*/,
     output wire branch_taken_execute,
     output wire [31:0] branch_target_execute,
     output reg is_branch_execute, // id_ex_branch
     output reg is_jump_execute,   // id_ex_jump
     output reg is_jalr_execute,   // id_ex_is_jalr
-    output wire [31:0] jalr_target_execute
+    output wire [31:0] jalr_target_execute,
+    output wire [31:0] prediction_history_execute,
+    output wire [4:0] rd_index_execute,   // id_ex_rd_index (return address stack)
+    output wire [4:0] rs1_index_execute,  // id_ex_rs1_index
+    output wire execute_advance,          // The EX instruction moves on to MEM this cycle
+
+    // Early branch resolution (ID stage)
+    output wire flush_due_to_branch_decode, // Conditional branch in ID redirects the fetch (correct_pc)
+    output wire branch_taken_decode,        // Its outcome (history repair)
+
+    output wire wait_for_interrupt // Parked on WFI with the pipeline drained (idle fast-forward)
 );
 
+    parameter MUL_LATENCY = 1; // MDU multiplier pipeline depth (0 = combinational)
+    parameter BRANCH_RESOLVE_DECODE = 0; // Resolve JAL, and conditional branches whose operands are ready, in ID
+    parameter DUAL_ISSUE = 0; // Second, ALU-only pipe; the first pipe keeps loads, stores, MDU, CSRs and control flow
+    parameter THREADS = 1; // Hardware contexts sharing the pipeline, switched on a load miss or WFI (1 to 4)
+
     // =========================================================================
     // Signal Declarations
     // =========================================================================
@@ -70,22 +92,35 @@ module backend (
     wire csr_to_register_select_decode;
     wire is_machine_return_decode;
     wire is_environment_call_decode;
+    wire is_wait_for_interrupt_decode;
     wire is_mdu_operation_decode; // New wire
     wire is_jalr_decode = (opcode == 7'b1100111);
 
     // Hazard / Stall Signals
-    wire stall_fetch_stage = !instruction_grant;
     wire stall_mem_stage = bus_busy;
     wire stall_hazard;
+    wire stall_load_use; // stall_hazard is a load-use hazard
     wire mdu_busy; 
     wire mdu_ready;
-    wire mdu_stall = id_ex_is_mdu_operation && !mdu_ready; // Stall until MDU is ready
-    assign stall_pipeline = stall_hazard || stall_mem_stage || mdu_stall; 
+    wire mdu_stall; // MDU instruction in EX cannot start yet
+    wire wfi_stall; // WFI in EX waits for an interrupt
+    wire mdu_writeback; // Out-of-band MDU result written through the second register file port
+    wire [31:0] mdu_result;
+    wire [4:0]  mdu_result_tag;
+    wire [31:0] pending_registers; // Scoreboard as seen by ID
+    assign stall_pipeline = stall_hazard || stall_mem_stage || mdu_stall || wfi_stall;
+
+    // --- Hardware Threads ---
+    reg [1:0] thread;   // Running context (register bank, CSRs)
+    wire thread_switch; // Squash the MEM-stage load (or the WFI) and everything younger, resume the next context
+    reg  [1:0] thread_next;      // Context the next switch resumes
+    reg        thread_next_runnable; // Some other context can run (not waiting on WFI)
 
     // --- ID/EX Pipeline Registers ---
     // id_ex_program_counter is output
     reg id_ex_prediction_taken;
     reg [31:0] id_ex_prediction_target;
+    reg [31:0] id_ex_prediction_history;
     reg [31:0] id_ex_rs1_data;
     reg [31:0] id_ex_rs2_data;
     reg [31:0] id_ex_immediate;
@@ -108,6 +143,7 @@ module backend (
     reg id_ex_csr_to_register_select;
     reg id_ex_is_machine_return;
     reg id_ex_is_environment_call;
+    reg id_ex_is_wait_for_interrupt;
     reg id_ex_is_mdu_operation; // New register
 
     // --- EX Stage Signals ---
@@ -117,12 +153,13 @@ module backend (
     wire [31:0] alu_input_b_execute;
     wire [31:0] forward_a_value;
     wire [31:0] forward_b_value;
-    wire [1:0] forward_a_select;
-    wire [1:0] forward_b_select;
+    wire [2:0] forward_a_select;
+    wire [2:0] forward_b_select;
     // branch_target_execute, branch_taken_execute are outputs
 
     // --- EX/MEM Pipeline Registers ---
     reg [31:0] ex_mem_alu_result;
+    reg [31:0] ex_mem_program_counter;
     reg [31:0] ex_mem_rs2_data;
     reg [4:0]  ex_mem_rd_index;
     reg [2:0]  ex_mem_function_3;
@@ -134,6 +171,8 @@ module backend (
     reg ex_mem_register_write_enable;
     reg ex_mem_csr_to_register_select;
     reg [31:0] ex_mem_csr_read_data;
+    reg ex_mem_valid;        // An instruction (not a bubble) is in MEM; see Performance Counters
+    reg ex_mem_second_valid;
 
     // --- MEM Stage Signals ---
     wire [31:0] memory_read_data_final;
@@ -153,6 +192,51 @@ module backend (
     // --- WB Stage Signals ---
     wire [31:0] write_data_writeback;
 
+    // --- Second Pipe (dual issue): ALU operations only, one stage register set per stage ---
+    wire [6:0] second_opcode;
+    wire [2:0] second_function_3;
+    wire [6:0] second_function_7;
+    wire [4:0] second_rd_index_decode;
+    wire [4:0] second_rs1_index_decode;
+    wire [4:0] second_rs2_index_decode;
+    wire [31:0] second_immediate_decode;
+    wire [31:0] second_rs1_data_decode;
+    wire [31:0] second_rs2_data_decode;
+    wire [2:0] second_alu_operation_code_decode;
+    wire second_alu_source_select_decode;
+    wire second_register_write_enable_decode;
+    wire second_alu_source_a_select_decode;
+    wire second_is_mdu_operation_decode;
+    wire stall_second; // Data hazard keeps the second instruction out of this cycle's pair
+
+    reg [31:0] id_ex_second_program_counter;
+    reg [31:0] id_ex_second_rs1_data;
+    reg [31:0] id_ex_second_rs2_data;
+    reg [31:0] id_ex_second_immediate;
+    reg [4:0]  id_ex_second_rs1_index;
+    reg [4:0]  id_ex_second_rs2_index;
+    reg [4:0]  id_ex_second_rd_index;
+    reg [2:0]  id_ex_second_function_3;
+    reg [6:0]  id_ex_second_function_7;
+    reg [2:0]  id_ex_second_alu_operation_code;
+    reg id_ex_second_alu_source_select;
+    reg id_ex_second_alu_source_a_select;
+    reg id_ex_second_register_write_enable;
+
+    wire [31:0] second_forward_a_value;
+    wire [31:0] second_forward_b_value;
+    wire [2:0] second_forward_a_select;
+    wire [2:0] second_forward_b_select;
+    wire [31:0] second_alu_result_execute;
+
+    reg [31:0] ex_mem_second_alu_result;
+    reg [4:0]  ex_mem_second_rd_index;
+    reg ex_mem_second_register_write_enable;
+
+    reg [31:0] mem_wb_second_alu_result;
+    reg [4:0]  mem_wb_second_rd_index;
+    reg mem_wb_second_register_write_enable;
+
     // =========================================================================
     // ID Stage
     // =========================================================================
@@ -188,19 +272,33 @@ module backend (
         .csr_to_register_select(csr_to_register_select_decode),
         .is_machine_return(is_machine_return_decode),
         .is_environment_call(is_environment_call_decode),
+        .is_wait_for_interrupt(is_wait_for_interrupt_decode),
         .is_mdu_operation(is_mdu_operation_decode) // Connected
     );
 
     // Register File
-    regfile u_regfile (
+    regfile #(
+        .THREADS(THREADS)
+    ) u_regfile (
         .clk(clk),
+        .thread(thread),
         .write_enable(mem_wb_register_write_enable),
         .rs1_index(rs1_index_decode),
         .rs2_index(rs2_index_decode),
         .rd_index(mem_wb_rd_index),
         .write_data(write_data_writeback),
+        .write_enable_2(mdu_writeback),
+        .rd_index_2(mdu_result_tag),
+        .write_data_2(mdu_result),
+        .write_enable_3(mem_wb_second_register_write_enable),
+        .rd_index_3(mem_wb_second_rd_index),
+        .write_data_3(mem_wb_second_alu_result),
         .rs1_read_data(rs1_data_decode),
-        .rs2_read_data(rs2_data_decode)
+        .rs2_read_data(rs2_data_decode),
+        .rs3_index(second_rs1_index_decode),
+        .rs4_index(second_rs2_index_decode),
+        .rs3_read_data(second_rs1_data_decode),
+        .rs4_read_data(second_rs2_data_decode)
     );
 
     // Immediate Generator
@@ -214,25 +312,36 @@ module backend (
     wire [31:0] mtvec;
     wire [31:0] mepc;
     wire interrupt_enable;
+    wire interrupt_pending;
+    wire [3:0] context_interrupt_pending;
     wire [31:0] csr_new_value; // Forwarding signal
+    wire [1:0] retire_count;
+    wire [8:0] performance_events;
     
-    control_status_register_file u_control_status_register_file (
+    control_status_register_file #(
+        .THREADS(THREADS)
+    ) u_control_status_register_file (
         .clk(clk),
         .rst_n(rst_n),
         .hart_id(hart_id), // Added: Hart ID
+        .thread(thread),
         .csr_address(id_ex_immediate[11:0]),
         .csr_write_enable(id_ex_csr_write_enable),
         .csr_write_data(forward_a_value),
         .csr_op(id_ex_function_3),
         .csr_read_data(csr_read_data_execute),
         .exception_enable(id_ex_is_environment_call),
-        .exception_program_counter(id_ex_program_counter),
+        .exception_program_counter(id_ex_is_wait_for_interrupt ? id_ex_program_counter + 32'd4 : id_ex_program_counter), // An interrupt at WFI returns past it
         .exception_cause(32'd11),
         .machine_return_enable(id_ex_is_machine_return),
         .timer_interrupt_request(timer_interrupt_request),
+        .retire_count(retire_count),
+        .performance_events(performance_events),
         .mtvec_out(mtvec),
         .mepc_out(mepc),
         .interrupt_enable(interrupt_enable),
+        .interrupt_pending(interrupt_pending),
+        .context_interrupt_pending(context_interrupt_pending),
         .csr_new_value_out(csr_new_value)
     );
 
@@ -242,15 +351,157 @@ module backend (
         .rs2_index_decode(rs2_index_decode),
         .rd_index_execute(id_ex_rd_index),
         .memory_read_enable_execute(id_ex_memory_read_enable),
-        .stall_pipeline(stall_hazard)
+        .rd_index_decode(rd_index_decode),
+        .register_write_enable_decode(register_write_enable_decode),
+        .pending_registers(pending_registers),
+        .rs1_index_second(second_rs1_index_decode),
+        .rs2_index_second(second_rs2_index_decode),
+        .rd_index_second(second_rd_index_decode),
+        .register_write_enable_second(second_register_write_enable_decode),
+        .stall_pipeline(stall_hazard),
+        .stall_load_use(stall_load_use),
+        .stall_second(stall_second)
+    );
+
+    // Early Branch Resolution
+    // Operands come from the register file (with WB and MDU write-through) or the MEM stage.
+    // A producer still in EX, or a load in MEM, leaves the branch to be resolved in EX.
+    // The second pipe's instruction in a stage is younger than the first pipe's and wins.
+    wire rs1_execute_hazard = (rs1_index_decode != 0) &&
+        ((id_ex_register_write_enable && (id_ex_rd_index == rs1_index_decode)) ||
+         (id_ex_second_register_write_enable && (id_ex_second_rd_index == rs1_index_decode)));
+    wire rs2_execute_hazard = (rs2_index_decode != 0) &&
+        ((id_ex_register_write_enable && (id_ex_rd_index == rs2_index_decode)) ||
+         (id_ex_second_register_write_enable && (id_ex_second_rd_index == rs2_index_decode)));
+    wire rs1_from_memory = (rs1_index_decode != 0) && ex_mem_register_write_enable && (ex_mem_rd_index == rs1_index_decode);
+    wire rs2_from_memory = (rs2_index_decode != 0) && ex_mem_register_write_enable && (ex_mem_rd_index == rs2_index_decode);
+    wire rs1_from_memory_second = (rs1_index_decode != 0) && ex_mem_second_register_write_enable && (ex_mem_second_rd_index == rs1_index_decode);
+    wire rs2_from_memory_second = (rs2_index_decode != 0) && ex_mem_second_register_write_enable && (ex_mem_second_rd_index == rs2_index_decode);
+    wire [31:0] memory_forward_value = ex_mem_csr_to_register_select ? ex_mem_csr_read_data : ex_mem_alu_result;
+
+    wire [31:0] branch_operand_a_decode = rs1_from_memory_second ? ex_mem_second_alu_result :
+                                          rs1_from_memory ? memory_forward_value : rs1_data_decode;
+    wire [31:0] branch_operand_b_decode = rs2_from_memory_second ? ex_mem_second_alu_result :
+                                          rs2_from_memory ? memory_forward_value : rs2_data_decode;
+    wire branch_operands_ready_decode = !rs1_execute_hazard && !rs2_execute_hazard &&
+                                        !((rs1_from_memory || rs2_from_memory) && ex_mem_memory_to_register_select);
+
+    wire branch_condition_met_decode;
+    branch_unit u_branch_unit_decode (
+        .function_3(function_3),
+        .operand_a(branch_operand_a_decode),
+        .operand_b(branch_operand_b_decode),
+        .branch_condition_met(branch_condition_met_decode)
     );
 
+    // Resolved when the branch moves on to EX this cycle; an older EX redirect or a trap wins
+    wire resolve_decode = (BRANCH_RESOLVE_DECODE != 0) && !stall_pipeline && !flush_due_to_branch && !flush_due_to_trap;
+    wire branch_resolved_decode = resolve_decode && branch_decode && branch_operands_ready_decode;
+    wire [31:0] branch_target_decode = if_id_program_counter + immediate_decode; // Branch or JAL target
+    assign branch_taken_decode = branch_condition_met_decode;
+
+    assign flush_due_to_branch_decode = branch_resolved_decode &&
+        ((if_id_prediction_taken != branch_taken_decode) ||
+         (if_id_prediction_taken && (if_id_prediction_target != branch_target_decode)));
+
+    // JAL needs no operands: it always resolves in ID, and redirects unless the BTB had its target
+    wire jal_decode = jump_decode && !is_jalr_decode;
+    wire jal_resolved_decode = resolve_decode && jal_decode;
+    assign flush_due_to_jump = jal_resolved_decode &&
+        (!if_id_prediction_taken || (if_id_prediction_target != branch_target_decode));
+
+    wire [31:0] correct_pc_decode = (jal_decode || branch_taken_decode) ? branch_target_decode : (if_id_program_counter + 4);
+
+    // Early resolution statistics
+    reg [31:0] branch_redirect_decode_count;
+    reg [31:0] branch_redirect_execute_count;
+    reg [31:0] jump_redirect_decode_count;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            branch_redirect_decode_count <= 0;
+            branch_redirect_execute_count <= 0;
+            jump_redirect_decode_count <= 0;
+        end else begin
+            if (flush_due_to_branch_decode) branch_redirect_decode_count <= branch_redirect_decode_count + 1;
+            if (flush_due_to_branch && execute_advance) branch_redirect_execute_count <= branch_redirect_execute_count + 1;
+            if (flush_due_to_jump) jump_redirect_decode_count <= jump_redirect_decode_count + 1;
+        end
+    end
+
+    // Second Issue Slot (dual issue)
+    // The instruction behind the ID instruction decodes alongside it and issues to the
+    // second pipe when both can leave ID together:
+    // - the first is no control transfer, no SYSTEM instruction and not predicted taken,
+    //   so nothing it does in EX can redirect past the second
+    // - the second is a plain ALU operation (OP without M, OP-IMM, LUI, AUIPC), not predicted taken
+    // - no data hazard (hazard detection unit: no bypass within a pair)
+    // - the first leaves ID this cycle and no redirect or trap is under way
+    instruction_decoder u_second_instruction_decoder (
+        .instruction(if_id_second_instruction),
+        .opcode(second_opcode),
+        .function_3(second_function_3),
+        .function_7(second_function_7),
+        .rd(second_rd_index_decode),
+        .rs1(second_rs1_index_decode),
+        .rs2(second_rs2_index_decode)
+    );
+
+    control_unit u_second_control_unit (
+        .opcode(second_opcode),
+        .function_3(second_function_3),
+        .function_7(second_function_7),
+        .rs2_index(second_rs2_index_decode),
+        .rs1_index(second_rs1_index_decode),
+        .branch(),
+        .jump(),
+        .memory_read_enable(),
+        .memory_to_register_select(),
+        .alu_operation_code(second_alu_operation_code_decode),
+        .memory_write_enable(),
+        .alu_source_select(second_alu_source_select_decode),
+        .register_write_enable(second_register_write_enable_decode),
+        .alu_source_a_select(second_alu_source_a_select_decode),
+        .csr_write_enable(),
+        .csr_to_register_select(),
+        .is_machine_return(),
+        .is_environment_call(),
+        .is_wait_for_interrupt(),
+        .is_mdu_operation(second_is_mdu_operation_decode)
+    );
+
+    immediate_generator u_second_immediate_generator (
+        .instruction(if_id_second_instruction),
+        .immediate(second_immediate_decode)
+    );
+
+    wire first_pairable_decode = !branch_decode && !jump_decode && (opcode != 7'b1110011) && !if_id_prediction_taken;
+    wire second_alu_decode = ((second_opcode == 7'b0110011) && !second_is_mdu_operation_decode) ||
+                             (second_opcode == 7'b0010011) || (second_opcode == 7'b0110111) ||
+                             (second_opcode == 7'b0010111);
+
+    assign issue_second = (DUAL_ISSUE != 0) && if_id_second_valid && !if_id_second_prediction_taken &&
+                          first_pairable_decode && second_alu_decode && !stall_second &&
+                          !stall_pipeline && !flush_due_to_branch && !flush_due_to_trap;
+
+    // Dual issue statistics: cycles that issued a pair
+    reg [31:0] dual_issue_count;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            dual_issue_count <= 0;
+        end else if (issue_second) begin
+            dual_issue_count <= dual_issue_count + 1;
+        end
+    end
+
     // ID/EX Pipeline Register
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             id_ex_program_counter <= 0;
             id_ex_prediction_taken <= 0;
             id_ex_prediction_target <= 0;
+            id_ex_prediction_history <= 0;
             id_ex_rs1_data <= 0;
             id_ex_rs2_data <= 0;
             id_ex_immediate <= 0;
@@ -273,12 +524,18 @@ module backend (
             id_ex_csr_to_register_select <= 0;
             id_ex_is_machine_return <= 0;
             id_ex_is_environment_call <= 0;
+            id_ex_is_wait_for_interrupt <= 0;
             is_jalr_execute <= 0;
             id_ex_is_mdu_operation <= 0; // Reset
-        end else if (stall_mem_stage || mdu_stall) begin // Stall if MDU is busy/not ready
+        end else if ((stall_mem_stage || mdu_stall || wfi_stall) && !thread_switch) begin // Stall if MDU is busy/not ready or WFI waits
             // Stall ID/EX (Hold value)
-        end else if (flush_due_to_branch || flush_due_to_jump || stall_hazard) begin
-            // Flush ID/EX (Insert Bubble)
+            if (!stall_mem_stage) begin
+                // Only EX waits: its operand producers drain out of MEM/WB, keep their values
+                id_ex_rs1_data <= forward_a_value;
+                id_ex_rs2_data <= forward_b_value;
+            end
+        end else if (flush_due_to_branch || stall_hazard || thread_switch || interrupt_enable) begin
+            // Flush ID/EX (Insert Bubble); on an interrupt the ID instruction runs after the handler
             is_branch_execute <= 0;
             is_jump_execute <= 0;
             id_ex_memory_read_enable <= 0;
@@ -287,16 +544,21 @@ module backend (
             id_ex_csr_write_enable <= 0;
             id_ex_is_machine_return <= 0;
             id_ex_is_environment_call <= 0;
+            id_ex_is_wait_for_interrupt <= 0;
             is_jalr_execute <= 0;
             id_ex_is_mdu_operation <= 0; // Flush
             
             id_ex_prediction_taken <= 0;
             id_ex_prediction_target <= 0;
+            id_ex_prediction_history <= 0;
             id_ex_program_counter <= 0; 
         end else begin
             id_ex_program_counter <= if_id_program_counter;
-            id_ex_prediction_taken <= if_id_prediction_taken;
-            id_ex_prediction_target <= if_id_prediction_target;
+            // A branch or JAL resolved in ID carries its outcome as the prediction, so EX agrees with it
+            id_ex_prediction_taken <= jal_resolved_decode ? 1'b1 :
+                                      branch_resolved_decode ? branch_taken_decode : if_id_prediction_taken;
+            id_ex_prediction_target <= (jal_resolved_decode || branch_resolved_decode) ? branch_target_decode : if_id_prediction_target;
+            id_ex_prediction_history <= if_id_prediction_history;
             id_ex_rs1_data <= rs1_data_decode;
             id_ex_rs2_data <= rs2_data_decode;
             id_ex_immediate <= immediate_decode;
@@ -319,11 +581,55 @@ module backend (
             id_ex_csr_to_register_select <= csr_to_register_select_decode;
             id_ex_is_machine_return <= is_machine_return_decode;
             id_ex_is_environment_call <= is_environment_call_decode;
+            id_ex_is_wait_for_interrupt <= is_wait_for_interrupt_decode;
             is_jalr_execute <= is_jalr_decode;
             id_ex_is_mdu_operation <= is_mdu_operation_decode; // Assign
         end
     end
 
+    // ID/EX Pipeline Register (second pipe): moves in step with the first; a bubble when no pair issued
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            id_ex_second_program_counter <= 0;
+            id_ex_second_rs1_data <= 0;
+            id_ex_second_rs2_data <= 0;
+            id_ex_second_immediate <= 0;
+            id_ex_second_rs1_index <= 0;
+            id_ex_second_rs2_index <= 0;
+            id_ex_second_rd_index <= 0;
+            id_ex_second_function_3 <= 0;
+            id_ex_second_function_7 <= 0;
+            id_ex_second_alu_operation_code <= 0;
+            id_ex_second_alu_source_select <= 0;
+            id_ex_second_alu_source_a_select <= 0;
+            id_ex_second_register_write_enable <= 0;
+        end else if ((stall_mem_stage || mdu_stall || wfi_stall) && !thread_switch) begin
+            // Hold with the first pipe
+            if (!stall_mem_stage) begin
+                id_ex_second_rs1_data <= second_forward_a_value;
+                id_ex_second_rs2_data <= second_forward_b_value;
+            end
+        end else if (!issue_second) begin
+            // Insert Bubble
+            id_ex_second_register_write_enable <= 0;
+            id_ex_second_program_counter <= 0;
+        end else begin
+            id_ex_second_program_counter <= if_id_second_program_counter;
+            id_ex_second_rs1_data <= second_rs1_data_decode;
+            id_ex_second_rs2_data <= second_rs2_data_decode;
+            id_ex_second_immediate <= second_immediate_decode;
+            id_ex_second_rs1_index <= second_rs1_index_decode;
+            id_ex_second_rs2_index <= second_rs2_index_decode;
+            id_ex_second_rd_index <= second_rd_index_decode;
+            id_ex_second_function_3 <= second_function_3;
+            id_ex_second_function_7 <= second_function_7;
+            id_ex_second_alu_operation_code <= second_alu_operation_code_decode;
+            id_ex_second_alu_source_select <= second_alu_source_select_decode;
+            id_ex_second_alu_source_a_select <= second_alu_source_a_select_decode;
+            id_ex_second_register_write_enable <= second_register_write_enable_decode;
+        end
+    end
+
     // =========================================================================
     // EX Stage
     // =========================================================================
@@ -336,17 +642,25 @@ module backend (
         .register_write_enable_memory(ex_mem_register_write_enable),
         .rd_index_writeback(mem_wb_rd_index),
         .register_write_enable_writeback(mem_wb_register_write_enable),
+        .rd_index_memory_second(ex_mem_second_rd_index),
+        .register_write_enable_memory_second(ex_mem_second_register_write_enable),
+        .rd_index_writeback_second(mem_wb_second_rd_index),
+        .register_write_enable_writeback_second(mem_wb_second_register_write_enable),
         .forward_a_select(forward_a_select),
         .forward_b_select(forward_b_select)
     );
 
-    // ALU Input Muxes (Forwarding)
-    assign forward_a_value = (forward_a_select == 2'b10) ? (ex_mem_csr_to_register_select ? ex_mem_csr_read_data : ex_mem_alu_result) :
-                           (forward_a_select == 2'b01) ? write_data_writeback :
+    // ALU Input Muxes (Forwarding; select codes in forwarding_unit)
+    assign forward_a_value = (forward_a_select == 3'b011) ? ex_mem_second_alu_result :
+                           (forward_a_select == 3'b010) ? memory_forward_value :
+                           (forward_a_select == 3'b100) ? mem_wb_second_alu_result :
+                           (forward_a_select == 3'b001) ? write_data_writeback :
                            id_ex_rs1_data;
 
-    assign forward_b_value = (forward_b_select == 2'b10) ? (ex_mem_csr_to_register_select ? ex_mem_csr_read_data : ex_mem_alu_result) :
-                           (forward_b_select == 2'b01) ? write_data_writeback :
+    assign forward_b_value = (forward_b_select == 3'b011) ? ex_mem_second_alu_result :
+                           (forward_b_select == 3'b010) ? memory_forward_value :
+                           (forward_b_select == 3'b100) ? mem_wb_second_alu_result :
+                           (forward_b_select == 3'b001) ? write_data_writeback :
                            id_ex_rs2_data;
 
     // ALU Source Muxes (Immediate vs Register)
@@ -371,24 +685,114 @@ module backend (
     );
 
     // MDU (Multiplication Division Unit)
-    wire [31:0] mdu_result;
-    
-    mdu u_mdu (
+    // Non-blocking: an operation leaves EX in the cycle it starts, its rd is marked in the
+    // scoreboard, and the result is written through the register file's second port.
+    // Combinational multiplies (MUL_LATENCY = 0) complete in EX like an ALU operation.
+    reg  [31:0] mdu_scoreboard;     // Registers waiting for an MDU result
+    reg  [2:0]  mdu_in_flight;      // Operations started but not written back
+    reg         mdu_divide_pending; // The operation in flight is a divide (runs alone)
+
+    wire mdu_divide_execute = id_ex_function_3[2];
+    wire mdu_in_band = !mdu_divide_execute && (MUL_LATENCY == 0);
+
+    // One result per cycle: a divide starts with nothing in flight, a multiply not behind a divide
+    wire mdu_can_start = mdu_divide_execute ? (mdu_in_flight == 0) : !mdu_divide_pending;
+    wire mdu_start = id_ex_is_mdu_operation && mdu_can_start && !stall_mem_stage;
+    wire mdu_issue = mdu_start && !mdu_in_band;
+    assign mdu_writeback = mdu_ready && !(mdu_start && mdu_in_band);
+    assign mdu_stall = id_ex_is_mdu_operation && !mdu_can_start;
+
+    wire [31:0] mdu_writeback_mask = mdu_writeback ? (32'd1 << mdu_result_tag) : 32'd0;
+    wire [31:0] mdu_execute_mask = (id_ex_is_mdu_operation && !mdu_in_band && id_ex_rd_index != 0) ?
+                                   (32'd1 << id_ex_rd_index) : 32'd0;
+
+    // ID sees the result written this cycle through the register file's write-through,
+    // and the out-of-band operation in EX as already pending
+    assign pending_registers = (mdu_scoreboard & ~mdu_writeback_mask) | mdu_execute_mask;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            mdu_scoreboard <= 0;
+            mdu_in_flight <= 0;
+            mdu_divide_pending <= 0;
+        end else begin
+            mdu_scoreboard <= (mdu_scoreboard & ~mdu_writeback_mask) |
+                              ((mdu_issue && id_ex_rd_index != 0) ? (32'd1 << id_ex_rd_index) : 32'd0);
+            mdu_in_flight <= mdu_in_flight + (mdu_issue ? 3'd1 : 3'd0) - (mdu_writeback ? 3'd1 : 3'd0);
+            if (mdu_issue && mdu_divide_execute) begin
+                mdu_divide_pending <= 1;
+            end else if (mdu_writeback) begin
+                mdu_divide_pending <= 0;
+            end
+        end
+    end
+
+    mdu #(
+        .MUL_LATENCY(MUL_LATENCY)
+    ) u_mdu (
         .clk(clk),
         .rst_n(rst_n),
-        .start(id_ex_is_mdu_operation && !mdu_busy && !mdu_ready), 
+        .start(mdu_start),
         .operation(id_ex_function_3),
         .operand_a(forward_a_value),
         .operand_b(forward_b_value),
+        .tag(id_ex_rd_index),
         .busy(mdu_busy),
         .ready(mdu_ready),
-        .result(mdu_result)
+        .result(mdu_result),
+        .result_tag(mdu_result_tag)
     );
 
     assign alu_result_execute = is_jump_execute ? (id_ex_program_counter + 32'd4) : 
                                 id_ex_is_mdu_operation ? mdu_result :
                                 alu_output_execute;
 
+    // Second Pipe (EX): ALU only, forwarded from both pipes like the first
+    forwarding_unit u_second_forwarding_unit (
+        .rs1_index_execute(id_ex_second_rs1_index),
+        .rs2_index_execute(id_ex_second_rs2_index),
+        .rd_index_memory(ex_mem_rd_index),
+        .register_write_enable_memory(ex_mem_register_write_enable),
+        .rd_index_writeback(mem_wb_rd_index),
+        .register_write_enable_writeback(mem_wb_register_write_enable),
+        .rd_index_memory_second(ex_mem_second_rd_index),
+        .register_write_enable_memory_second(ex_mem_second_register_write_enable),
+        .rd_index_writeback_second(mem_wb_second_rd_index),
+        .register_write_enable_writeback_second(mem_wb_second_register_write_enable),
+        .forward_a_select(second_forward_a_select),
+        .forward_b_select(second_forward_b_select)
+    );
+
+    assign second_forward_a_value = (second_forward_a_select == 3'b011) ? ex_mem_second_alu_result :
+                                  (second_forward_a_select == 3'b010) ? memory_forward_value :
+                                  (second_forward_a_select == 3'b100) ? mem_wb_second_alu_result :
+                                  (second_forward_a_select == 3'b001) ? write_data_writeback :
+                                  id_ex_second_rs1_data;
+
+    assign second_forward_b_value = (second_forward_b_select == 3'b011) ? ex_mem_second_alu_result :
+                                  (second_forward_b_select == 3'b010) ? memory_forward_value :
+                                  (second_forward_b_select == 3'b100) ? mem_wb_second_alu_result :
+                                  (second_forward_b_select == 3'b001) ? write_data_writeback :
+                                  id_ex_second_rs2_data;
+
+    wire [31:0] second_alu_input_a_execute = id_ex_second_alu_source_a_select ? id_ex_second_program_counter : second_forward_a_value;
+    wire [31:0] second_alu_input_b_execute = id_ex_second_alu_source_select   ? id_ex_second_immediate : second_forward_b_value;
+
+    wire [3:0] second_alu_control_code_execute;
+    alu_control_unit u_second_alu_control_unit (
+        .alu_operation_code(id_ex_second_alu_operation_code),
+        .function_3(id_ex_second_function_3),
+        .function_7(id_ex_second_function_7),
+        .alu_control_code(second_alu_control_code_execute)
+    );
+
+    alu u_second_alu (
+        .a(second_alu_input_a_execute),
+        .b(second_alu_input_b_execute),
+        .alu_control_code(second_alu_control_code_execute),
+        .result(second_alu_result_execute)
+    );
+
     // Branch Logic
     assign branch_target_execute = id_ex_program_counter + id_ex_immediate;
 
@@ -415,11 +819,14 @@ module backend (
         (is_control_execute && id_ex_prediction_taken && (id_ex_prediction_target != actual_target)) ||
         (!is_control_execute && id_ex_prediction_taken);
 
-    assign correct_pc = actual_taken ? actual_target : (id_ex_program_counter + 4);
+    assign correct_pc = mispredict ? (actual_taken ? actual_target : (id_ex_program_counter + 4)) : correct_pc_decode;
 
     assign flush_due_to_branch = mispredict;
-    assign flush_due_to_jump   = 0; 
-    assign flush_due_to_trap   = interrupt_enable || is_environment_call_decode || is_machine_return_decode;
+    assign prediction_history_execute = id_ex_prediction_history;
+    assign rd_index_execute = id_ex_rd_index;
+    assign rs1_index_execute = id_ex_rs1_index;
+    assign execute_advance = !(stall_mem_stage || mdu_stall || wfi_stall);
+    assign flush_due_to_trap   = interrupt_enable || is_environment_call_decode || is_machine_return_decode || thread_switch;
 
     // CSR Forwarding Logic
     wire [11:0] csr_write_address_execute = id_ex_immediate[11:0];
@@ -429,9 +836,128 @@ module backend (
     assign mtvec_forwarded = (id_ex_csr_write_enable && (csr_write_address_execute == 12'h305)) ? csr_new_value : mtvec;
     assign mepc_forwarded  = (id_ex_csr_write_enable && (csr_write_address_execute == 12'h341)) ? csr_new_value : mepc;
 
+    // Wait For Interrupt
+    // WFI holds EX, like an MDU instruction that cannot start, until an enabled interrupt is
+    // pending (mie & mip, whether or not mstatus.MIE is set); the front of the pipeline stops
+    // and MEM drains. If the interrupt is taken, mepc points past the WFI. With several
+    // contexts the WFI gives the pipeline to another one (see below); the core is only parked
+    // when no other context can run.
+    assign wfi_stall = id_ex_is_wait_for_interrupt && !interrupt_pending;
+    assign wait_for_interrupt = wfi_stall && !stall_mem_stage && !thread_next_runnable;
+
+    // Hardware Threads (switch on miss)
+    // Each context has its own register bank, CSRs and resume PC; one runs at a time. When a
+    // cacheable load of the running context waits in MEM, the load and everything younger are
+    // squashed and the next context resumes at its saved PC (like a trap redirect). The D-Cache
+    // carries on with the refill, and the load replays when its context comes back.
+    // Nothing with a side effect may be squashed: no MDU result in flight (it would be written
+    // to the next context's bank), no CSR write, ECALL or MRET in EX, no interrupt being taken.
+    // A context that resumed completes a load before it can switch again, so each one progresses.
+    // A WFI waiting in EX also switches, once MEM has drained, and its context resumes at the WFI.
+    // Such a context is skipped until its own interrupt (mie & mip) is pending, then replays
+    // the WFI, which completes or takes the trap.
+    reg [31:0] thread_program_counter [0:THREADS-1]; // Resume PC of each context
+    reg        thread_load_done; // The running context completed a load since it resumed
+    reg [THREADS-1:0] thread_waiting; // Switched away on WFI
+    reg [31:0] thread_switch_count;
+
+    // Next context in round-robin order that can run (thread itself if none)
+    integer r;
+    always @(*) begin
+        thread_next = thread;
+        thread_next_runnable = 0;
+        for (r = THREADS - 1; r >= 1; r = r - 1) begin
+            if (!thread_waiting[(thread + r) % THREADS] || context_interrupt_pending[(thread + r) % THREADS]) begin
+                thread_next = (thread + r) % THREADS;
+                thread_next_runnable = 1;
+            end
+        end
+    end
+
+    wire load_wait_memory = stall_mem_stage && ex_mem_memory_read_enable && (ex_mem_alu_result[31:30] == 2'b00);
+    wire load_switch = load_wait_memory && thread_load_done && (mdu_in_flight == 0) &&
+                       !id_ex_csr_write_enable && !id_ex_is_environment_call && !id_ex_is_machine_return &&
+                       !interrupt_enable;
+    wire wfi_switch = wfi_stall && !stall_mem_stage && !ex_mem_valid && !ex_mem_second_valid && (mdu_in_flight == 0);
+
+    assign thread_switch = (THREADS > 1) && thread_next_runnable && (load_switch || wfi_switch);
+
+    integer t;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            thread <= 0;
+            thread_load_done <= 1;
+            thread_waiting <= 0;
+            thread_switch_count <= 0;
+            for (t = 0; t < THREADS; t = t + 1) begin
+                thread_program_counter[t] <= 0; // Every context starts at the reset vector
+            end
+        end else if (thread_switch) begin
+            thread_program_counter[thread] <= wfi_switch ? id_ex_program_counter : ex_mem_program_counter; // Replay the WFI or the load
+            thread_waiting[thread] <= wfi_switch;
+            thread_waiting[thread_next] <= 0;
+            thread <= thread_next;
+            thread_load_done <= 0;
+            thread_switch_count <= thread_switch_count + 1;
+        end else if (ex_mem_memory_read_enable && !stall_mem_stage) begin
+            thread_load_done <= 1;
+        end
+    end
+
+    // Performance Counters
+    // Retirement: valid bits follow the instructions down both pipes (bubbles and an empty
+    // fetch queue are 0); an instruction retires when it leaves MEM.
+    reg id_ex_valid;
+    reg id_ex_second_valid;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            id_ex_valid <= 0;
+            id_ex_second_valid <= 0;
+            ex_mem_valid <= 0;
+            ex_mem_second_valid <= 0;
+        end else begin
+            if ((stall_mem_stage || mdu_stall || wfi_stall) && !thread_switch) begin
+                // Hold with ID/EX
+            end else if (flush_due_to_branch || stall_hazard || thread_switch || interrupt_enable) begin
+                id_ex_valid <= 0;
+                id_ex_second_valid <= 0;
+            end else begin
+                id_ex_valid <= (if_id_instruction != 32'b0);
+                id_ex_second_valid <= issue_second;
+            end
+
+            if (stall_mem_stage && !thread_switch) begin
+                // Hold with EX/MEM
+            end else if (mdu_stall || wfi_stall || thread_switch) begin
+                ex_mem_valid <= 0;
+                ex_mem_second_valid <= 0;
+            end else begin
+                ex_mem_valid <= id_ex_valid;
+                ex_mem_second_valid <= id_ex_second_valid;
+            end
+        end
+    end
+
+    assign retire_count = (stall_mem_stage || thread_switch) ? 2'd0 : ({1'b0, ex_mem_valid} + {1'b0, ex_mem_second_valid});
+
+    // Events selectable by mhpmevent (one bit per event number; stall events count lost cycles)
+    assign performance_events[0] = 1'b0;                 // No event
+    assign performance_events[1] = cache_miss_events[0]; // I-Cache miss
+    assign performance_events[2] = cache_miss_events[1]; // D-Cache miss
+    assign performance_events[3] = cache_miss_events[2]; // L2 miss (for this tile)
+    assign performance_events[4] = (flush_due_to_branch && execute_advance) ||
+                                   flush_due_to_branch_decode || flush_due_to_jump; // Branch or jump mispredict
+    assign performance_events[5] = stall_load_use && !stall_mem_stage && !mdu_stall && !wfi_stall; // Load-use stall
+    assign performance_events[6] = !stall_mem_stage &&
+                                   (mdu_stall || (stall_hazard && !stall_load_use)); // MDU stall (structural or scoreboard)
+    assign performance_events[7] = stall_mem_stage; // Bus wait (MEM waits for the D-Cache or store buffer)
+    assign performance_events[8] = interrupt_enable || (id_ex_is_environment_call && execute_advance); // Trap taken
+
     // Trap PC Logic
-    assign trap_pc = (interrupt_enable || is_environment_call_decode) ? mtvec_forwarded : mepc_forwarded;
-    assign pc_mux_select_trap = interrupt_enable || is_environment_call_decode || is_machine_return_decode;
+    assign trap_pc = thread_switch ? thread_program_counter[thread_next] :
+                     (interrupt_enable || is_environment_call_decode) ? mtvec_forwarded : mepc_forwarded;
+    assign pc_mux_select_trap = interrupt_enable || is_environment_call_decode || is_machine_return_decode || thread_switch;
 
     // EX/MEM Pipeline Register
     always @(posedge clk or negedge rst_n) begin
@@ -446,10 +972,11 @@ module backend (
             ex_mem_register_write_enable <= 0;
             ex_mem_csr_to_register_select <= 0;
             ex_mem_csr_read_data <= 0;
-        end else if (stall_mem_stage) begin
+            ex_mem_program_counter <= 0;
+        end else if (stall_mem_stage && !thread_switch) begin
             // Stall EX/MEM (Hold value)
-        end else if (mdu_stall) begin
-            // Insert Bubble (NOP) while MDU is busy/not ready
+        end else if (mdu_stall || wfi_stall || thread_switch) begin
+            // Insert Bubble (NOP) while MDU is busy/not ready or WFI waits, or squash on a thread switch
             ex_mem_memory_read_enable <= 0;
             ex_mem_memory_write_enable <= 0;
             ex_mem_register_write_enable <= 0;
@@ -460,24 +987,48 @@ module backend (
             ex_mem_function_3 <= 0;
             ex_mem_memory_to_register_select <= 0;
             ex_mem_csr_read_data <= 0;
+            ex_mem_program_counter <= 0;
         end else begin
             ex_mem_alu_result <= alu_result_execute;
+            ex_mem_program_counter <= id_ex_program_counter;
             ex_mem_rs2_data <= forward_b_value;
             ex_mem_rd_index <= id_ex_rd_index;
             ex_mem_function_3 <= id_ex_function_3;
             ex_mem_memory_read_enable <= id_ex_memory_read_enable;
             ex_mem_memory_to_register_select <= id_ex_memory_to_register_select;
             ex_mem_memory_write_enable <= id_ex_memory_write_enable;
-            ex_mem_register_write_enable <= id_ex_register_write_enable;
+            ex_mem_register_write_enable <= id_ex_register_write_enable && !mdu_issue; // MDU writes back later
             ex_mem_csr_to_register_select <= id_ex_csr_to_register_select;
             ex_mem_csr_read_data <= csr_read_data_execute;
         end
     end
 
+    // EX/MEM Pipeline Register (second pipe)
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            ex_mem_second_alu_result <= 0;
+            ex_mem_second_rd_index <= 0;
+            ex_mem_second_register_write_enable <= 0;
+        end else if (stall_mem_stage && !thread_switch) begin
+            // Stall EX/MEM (Hold value)
+        end else if (mdu_stall || wfi_stall || thread_switch) begin
+            // Insert Bubble: the pair waits in EX with the MDU or WFI instruction, or is squashed
+            ex_mem_second_register_write_enable <= 0;
+            ex_mem_second_rd_index <= 0;
+            ex_mem_second_alu_result <= 0;
+        end else begin
+            ex_mem_second_alu_result <= second_alu_result_execute;
+            ex_mem_second_rd_index <= id_ex_second_rd_index;
+            ex_mem_second_register_write_enable <= id_ex_second_register_write_enable;
+        end
+    end
+
     // =========================================================================
     // MEM Stage
     // =========================================================================
 
+    assign bus_program_counter = ex_mem_program_counter;
+
     // Load Store Unit
     load_store_unit u_load_store_unit (
         .address(ex_mem_alu_result),
@@ -504,6 +1055,10 @@ module backend (
             mem_wb_register_write_enable <= 0;
             mem_wb_csr_to_register_select <= 0;
             mem_wb_csr_read_data <= 0;
+        end else if (thread_switch) begin
+            // The squashed load does not write back
+            mem_wb_register_write_enable <= 0;
+            mem_wb_rd_index <= 0;
         end else if (stall_mem_stage) begin
             // Stall MEM/WB (Hold value)
         end else begin
@@ -517,6 +1072,25 @@ module backend (
         end
     end
 
+    // MEM/WB Pipeline Register (second pipe)
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            mem_wb_second_alu_result <= 0;
+            mem_wb_second_rd_index <= 0;
+            mem_wb_second_register_write_enable <= 0;
+        end else if (thread_switch) begin
+            // Squashed with the load it was paired with
+            mem_wb_second_register_write_enable <= 0;
+            mem_wb_second_rd_index <= 0;
+        end else if (stall_mem_stage) begin
+            // Stall MEM/WB (Hold value)
+        end else begin
+            mem_wb_second_alu_result <= ex_mem_second_alu_result;
+            mem_wb_second_rd_index <= ex_mem_second_rd_index;
+            mem_wb_second_register_write_enable <= ex_mem_second_register_write_enable;
+        end
+    end
+
     // =========================================================================
     // WB Stage
     // =========================================================================
@@ -1,7 +1,8 @@
 module control_status_register_file (
     input wire clk,
     input wire rst_n,
-    input wire [31:0] hart_id, // Added: Hart ID
+    input wire [31:0] hart_id, // Added: Hart ID (of context 0; context t reports hart_id + t)
+    input wire [1:0] thread,   // Running hardware context: its CSRs are read and written
     
     // Read/Write ports
     input wire [11:0] csr_address,
@@ -16,10 +17,16 @@ module control_status_register_file (
     input wire [31:0] exception_cause, // Cause code
     input wire machine_return_enable,           // Return from exception (MRET instruction)
     input wire timer_interrupt_request,         // Timer Interrupt Input
+
+    // Performance Counters
+    input wire [1:0] retire_count,              // Instructions leaving MEM this cycle (0 to 2)
+    input wire [8:0] performance_events,        // Event n happened this cycle (mhpmevent = n); bit 0 is unused
     
     output wire [31:0] mtvec_out, // Trap Vector Base Address
     output wire [31:0] mepc_out,  // Exception PC (for MRET)
     output reg interrupt_enable,       // Trigger interrupt trap
+    output wire interrupt_pending,     // An enabled interrupt is pending (wakes WFI, ignores mstatus.MIE)
+    output reg [3:0] context_interrupt_pending, // interrupt_pending of each context (wakes a context parked on WFI)
     output wire [31:0] csr_new_value_out // Forwarding: The value that will be written
 );
 
@@ -32,14 +39,47 @@ module control_status_register_file (
     localparam CSR_MIP     = 12'h344; // Machine Interrupt Pending
     localparam CSR_MHARTID = 12'hf14; // Hardware Thread ID
 
-    // Registers
-    reg [31:0] mstatus; // Bit 3 = MIE (Global Interrupt Enable), Bit 7 = MPIE
-    reg [31:0] mie;     // Bit 7 = MTIE (Timer Interrupt Enable)
-    reg [31:0] mtvec;
-    reg [31:0] mepc;
-    reg [31:0] mcause;
+    // Counters (Zicntr/Zihpm): low halves, high halves at +0x80, user read-only copies at 0xC00/0xC80
+    localparam CSR_MCOUNTINHIBIT = 12'h320;
+    localparam CSR_MHPMEVENT3    = 12'h323; // mhpmevent3.. (one per programmable counter)
+    localparam CSR_MCYCLE        = 12'hb00;
+    localparam CSR_MINSTRET      = 12'hb02;
+    localparam CSR_MHPMCOUNTER3  = 12'hb03;
+    localparam CSR_MCYCLEH       = 12'hb80;
+    localparam CSR_MINSTRETH     = 12'hb82;
+    localparam CSR_MHPMCOUNTER3H = 12'hb83;
+    localparam CSR_CYCLE         = 12'hc00;
+    localparam CSR_INSTRET       = 12'hc02;
+    localparam CSR_HPMCOUNTER3   = 12'hc03;
+    localparam CSR_CYCLEH        = 12'hc80;
+    localparam CSR_INSTRETH      = 12'hc82;
+    localparam CSR_HPMCOUNTER3H  = 12'hc83;
+
+    parameter THREADS = 1; // Hardware contexts, one set of machine-mode CSRs each (1 to 4)
+    parameter HPM_COUNTERS = 8; // Programmable counters mhpmcounter3 and up (up to 29)
+
+    // Registers (one per context)
+    reg [31:0] mstatus_context [0:THREADS-1]; // Bit 3 = MIE (Global Interrupt Enable), Bit 7 = MPIE
+    reg [31:0] mie_context [0:THREADS-1];     // Bit 7 = MTIE (Timer Interrupt Enable)
+    reg [31:0] mtvec_context [0:THREADS-1];
+    reg [31:0] mepc_context [0:THREADS-1];
+    reg [31:0] mcause_context [0:THREADS-1];
     wire [31:0] mip;    // Bit 7 = MTIP (Timer Interrupt Pending)
 
+    // Performance Counters (shared by all contexts of the core)
+    reg [63:0] mcycle;
+    reg [63:0] minstret;
+    reg [63:0] mhpmcounter [0:HPM_COUNTERS-1]; // mhpmcounter3 + h
+    reg [31:0] mhpmevent [0:HPM_COUNTERS-1];   // Event number counted by mhpmcounter3 + h
+    reg [31:0] mcountinhibit;                  // Bit 0 = CY, bit 2 = IR, bit 3 + h = HPM3 + h
+
+    // The running context's copies
+    wire [31:0] mstatus = mstatus_context[thread];
+    wire [31:0] mie = mie_context[thread];
+    wire [31:0] mtvec = mtvec_context[thread];
+    wire [31:0] mepc = mepc_context[thread];
+    wire [31:0] mcause = mcause_context[thread];
+
     // MIP is read-only for software (mostly), reflects hardware signals
     assign mip = {24'b0, timer_interrupt_request, 7'b0};
 
@@ -52,12 +92,22 @@ module control_status_register_file (
     // Note: In a real pipeline, we need to be careful about priority vs exception
     // Here we assume check happens at WB or before Fetch next
     wire timer_interrupt_fire = global_ie && timer_ie && timer_ip;
+    assign interrupt_pending = timer_ie && timer_ip;
+
+    integer w;
+    always @(*) begin
+        context_interrupt_pending = 4'b0;
+        for (w = 0; w < THREADS; w = w + 1) begin
+            context_interrupt_pending[w] = mie_context[w][7] && timer_ip;
+        end
+    end
 
     always @(*) begin
         interrupt_enable = timer_interrupt_fire;
     end
 
     // Read Logic
+    integer h;
     always @(*) begin
         case (csr_address)
             CSR_MSTATUS: csr_read_data = mstatus;
@@ -66,8 +116,23 @@ module control_status_register_file (
             CSR_MEPC:    csr_read_data = mepc;
             CSR_MCAUSE:  csr_read_data = mcause;
             CSR_MIP:     csr_read_data = mip;
-            CSR_MHARTID: csr_read_data = hart_id;
-            default:     csr_read_data = 32'b0;
+            CSR_MHARTID: csr_read_data = hart_id + {30'b0, thread};
+            CSR_MCOUNTINHIBIT: csr_read_data = mcountinhibit;
+            CSR_MCYCLE,   CSR_CYCLE:    csr_read_data = mcycle[31:0];
+            CSR_MCYCLEH,  CSR_CYCLEH:   csr_read_data = mcycle[63:32];
+            CSR_MINSTRET, CSR_INSTRET:  csr_read_data = minstret[31:0];
+            CSR_MINSTRETH, CSR_INSTRETH: csr_read_data = minstret[63:32];
+            default: begin
+                csr_read_data = 32'b0;
+                for (h = 0; h < HPM_COUNTERS; h = h + 1) begin
+                    if (csr_address == CSR_MHPMCOUNTER3 + h || csr_address == CSR_HPMCOUNTER3 + h)
+                        csr_read_data = mhpmcounter[h][31:0];
+                    if (csr_address == CSR_MHPMCOUNTER3H + h || csr_address == CSR_HPMCOUNTER3H + h)
+                        csr_read_data = mhpmcounter[h][63:32];
+                    if (csr_address == CSR_MHPMEVENT3 + h)
+                        csr_read_data = mhpmevent[h];
+                end
+            end
         endcase
     end
 
@@ -85,48 +150,91 @@ module control_status_register_file (
     assign csr_new_value_out = new_csr_value;
 
     // Write Logic
+    integer t;
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
-            mstatus <= 32'b0;
-            mie     <= 32'b0;
-            mtvec   <= 32'b0;
-            mepc    <= 32'b0;
-            mcause  <= 32'b0;
+            for (t = 0; t < THREADS; t = t + 1) begin
+                mstatus_context[t] <= 32'b0;
+                mie_context[t]     <= 32'b0;
+                mtvec_context[t]   <= 32'b0;
+                mepc_context[t]    <= 32'b0;
+                mcause_context[t]  <= 32'b0;
+            end
         end else begin
             // Priority: Reset > Exception/Interrupt > Software Write
             
             if (timer_interrupt_fire) begin
-                mepc   <= exception_program_counter; // Save current PC (or next PC depending on arch)
-                mcause <= 32'h80000007; // Interrupt bit (31) + Cause 7 (Timer)
+                mepc_context[thread]   <= exception_program_counter; // Save current PC (or next PC depending on arch)
+                mcause_context[thread] <= 32'h80000007; // Interrupt bit (31) + Cause 7 (Timer)
                 
                 // Disable Global Interrupts
                 // Save MIE to MPIE (Bit 7)
-                mstatus[7] <= mstatus[3];
+                mstatus_context[thread][7] <= mstatus[3];
                 // Clear MIE (Bit 3)
-                mstatus[3] <= 1'b0;
+                mstatus_context[thread][3] <= 1'b0;
             end
             else if (exception_enable) begin
-                mepc   <= exception_program_counter;
-                mcause <= exception_cause;
+                mepc_context[thread]   <= exception_program_counter;
+                mcause_context[thread] <= exception_cause;
                 // Save MIE to MPIE
-                mstatus[7] <= mstatus[3];
+                mstatus_context[thread][7] <= mstatus[3];
                 // Clear MIE
-                mstatus[3] <= 1'b0;
+                mstatus_context[thread][3] <= 1'b0;
             end 
             else if (machine_return_enable) begin
                 // Restore MIE from MPIE
-                mstatus[3] <= mstatus[7];
+                mstatus_context[thread][3] <= mstatus[7];
                 // Set MPIE to 1 (standard says 1)
-                mstatus[7] <= 1'b1;
+                mstatus_context[thread][7] <= 1'b1;
             end
             // Software Write (CSR Instructions)
             else if (csr_write_enable) begin
                 case (csr_address)
-                    CSR_MSTATUS: mstatus <= new_csr_value;
-                    CSR_MIE:     mie     <= new_csr_value;
-                    CSR_MTVEC:   mtvec   <= new_csr_value;
-                    CSR_MEPC:    mepc    <= new_csr_value;
-                    CSR_MCAUSE:  mcause  <= new_csr_value;
+                    CSR_MSTATUS: mstatus_context[thread] <= new_csr_value;
+                    CSR_MIE:     mie_context[thread]     <= new_csr_value;
+                    CSR_MTVEC:   mtvec_context[thread]   <= new_csr_value;
+                    CSR_MEPC:    mepc_context[thread]    <= new_csr_value;
+                    CSR_MCAUSE:  mcause_context[thread]  <= new_csr_value;
+                endcase
+            end
+        end
+    end
+
+    // Counter Logic
+    // Counters tick unless inhibited; a software write to a counter half wins over its increment.
+    // The user-mode copies (cycle, instret, hpmcounter) are read-only.
+    integer c;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            mcycle <= 64'b0;
+            minstret <= 64'b0;
+            mcountinhibit <= 32'b0;
+            for (c = 0; c < HPM_COUNTERS; c = c + 1) begin
+                mhpmcounter[c] <= 64'b0;
+                mhpmevent[c] <= 32'b0;
+            end
+        end else begin
+            if (!mcountinhibit[0]) mcycle <= mcycle + 1;
+            if (!mcountinhibit[2]) minstret <= minstret + {62'b0, retire_count};
+            for (c = 0; c < HPM_COUNTERS; c = c + 1) begin
+                if (!mcountinhibit[3 + c] && (mhpmevent[c] < 9) && performance_events[mhpmevent[c][3:0]])
+                    mhpmcounter[c] <= mhpmcounter[c] + 1;
+            end
+
+            if (csr_write_enable) begin
+                case (csr_address)
+                    CSR_MCOUNTINHIBIT: mcountinhibit <= new_csr_value & ~32'h2; // No time counter
+                    CSR_MCYCLE:    mcycle[31:0]    <= new_csr_value;
+                    CSR_MCYCLEH:   mcycle[63:32]   <= new_csr_value;
+                    CSR_MINSTRET:  minstret[31:0]  <= new_csr_value;
+                    CSR_MINSTRETH: minstret[63:32] <= new_csr_value;
+                    default: begin
+                        for (c = 0; c < HPM_COUNTERS; c = c + 1) begin
+                            if (csr_address == CSR_MHPMCOUNTER3 + c)  mhpmcounter[c][31:0] <= new_csr_value;
+                            if (csr_address == CSR_MHPMCOUNTER3H + c) mhpmcounter[c][63:32] <= new_csr_value;
+                            if (csr_address == CSR_MHPMEVENT3 + c)    mhpmevent[c] <= new_csr_value;
+                        end
+                    end
                 endcase
             end
         end
@@ -17,6 +17,7 @@ module control_unit (
     output reg csr_to_register_select,
     output reg is_machine_return,
     output reg is_environment_call,
+    output reg is_wait_for_interrupt,
     output reg is_mdu_operation 
 );
 
@@ -35,6 +36,7 @@ module control_unit (
         csr_to_register_select    = 0;
         is_machine_return         = 0;
         is_environment_call       = 0;
+        is_wait_for_interrupt     = 0;
         is_mdu_operation          = 0;
 
         case (opcode)
@@ -106,15 +108,17 @@ module control_unit (
                 alu_operation_code    = 3'b000; // Add (PC + Imm)
             end
 
-            // SYSTEM (CSRs, ECALL, MRET)
+            // SYSTEM (CSRs, ECALL, MRET, WFI)
             7'b1110011: begin
                 case (function_3)
-                    3'b000: begin // ECALL or MRET
+                    3'b000: begin // ECALL, MRET or WFI
                         register_write_enable = 0;
                         if (function_7 == 7'b0000000 && rs2_index == 5'b00000) begin
                             is_environment_call = 1;
                         end else if (function_7 == 7'b0011000 && rs2_index == 5'b00010) begin
                             is_machine_return = 1;
+                        end else if (function_7 == 7'b0001000 && rs2_index == 5'b00101) begin
+                            is_wait_for_interrupt = 1;
                         end
                     end
                     
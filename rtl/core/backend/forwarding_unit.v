@@ -5,39 +5,60 @@ module forwarding_unit (
     input wire register_write_enable_memory,     // RegWrite signal in MEM stage
     input wire [4:0] rd_index_writeback,       // RD address in WB stage
     input wire register_write_enable_writeback,      // RegWrite signal in WB stage
+    // Second pipe (dual issue): younger than the first pipe's instruction in the same stage
+    input wire [4:0] rd_index_memory_second,
+    input wire register_write_enable_memory_second,
+    input wire [4:0] rd_index_writeback_second,
+    input wire register_write_enable_writeback_second,
     
-    output reg [1:0] forward_a_select,   // Forwarding control for ALU Operand A
-    output reg [1:0] forward_b_select    // Forwarding control for ALU Operand B
+    output reg [2:0] forward_a_select,   // Forwarding control for ALU Operand A
+    output reg [2:0] forward_b_select    // Forwarding control for ALU Operand B
 );
 
+    // Select encoding: 000 register file, 001 WB, 010 MEM, 011 MEM (second pipe), 100 WB (second pipe).
+    // Priority goes to the most recent producer: MEM before WB, second pipe before first.
+
     // Forwarding for Operand A (RS1)
     always @(*) begin
-        // EX Hazard: Forward from MEM stage
-        if (register_write_enable_memory && (rd_index_memory != 0) && (rd_index_memory == rs1_index_execute)) begin
-            forward_a_select = 2'b10;
+        // EX Hazard: Forward from MEM stage (second pipe first)
+        if (register_write_enable_memory_second && (rd_index_memory_second != 0) && (rd_index_memory_second == rs1_index_execute)) begin
+            forward_a_select = 3'b011;
+        end
+        else if (register_write_enable_memory && (rd_index_memory != 0) && (rd_index_memory == rs1_index_execute)) begin
+            forward_a_select = 3'b010;
         end
         // MEM Hazard: Forward from WB stage
         // Only forward if EX hazard condition isn't met (priority to most recent)
+        else if (register_write_enable_writeback_second && (rd_index_writeback_second != 0) && (rd_index_writeback_second == rs1_index_execute)) begin
+            forward_a_select = 3'b100;
+        end
         else if (register_write_enable_writeback && (rd_index_writeback != 0) && (rd_index_writeback == rs1_index_execute)) begin
-            forward_a_select = 2'b01;
+            forward_a_select = 3'b001;
         end
         else begin
-            forward_a_select = 2'b00; // No forwarding
+            forward_a_select = 3'b000; // No forwarding
         end
     end
 
     // Forwarding for Operand B (RS2)
     always @(*) begin
-        // EX Hazard: Forward from MEM stage
-        if (register_write_enable_memory && (rd_index_memory != 0) && (rd_index_memory == rs2_index_execute)) begin
-            forward_b_select = 2'b10;
+        // EX Hazard: Forward from MEM stage (second pipe first)
+        if (register_write_enable_memory_second && (rd_index_memory_second != 0) && (rd_index_memory_second == rs2_index_execute)) begin
+            forward_b_select = 3'b011;
+        end
+        else if (register_write_enable_memory && (rd_index_memory != 0) && (rd_index_memory == rs2_index_execute)) begin
+            forward_b_select = 3'b010;
         end
         // MEM Hazard: Forward from WB stage
+        // Only forward if EX hazard condition isn't met (priority to most recent)
+        else if (register_write_enable_writeback_second && (rd_index_writeback_second != 0) && (rd_index_writeback_second == rs2_index_execute)) begin
+            forward_b_select = 3'b100;
+        end
         else if (register_write_enable_writeback && (rd_index_writeback != 0) && (rd_index_writeback == rs2_index_execute)) begin
-            forward_b_select = 2'b01;
+            forward_b_select = 3'b001;
         end
         else begin
-            forward_b_select = 2'b00; // No forwarding
+            forward_b_select = 3'b000; // No forwarding
         end
     end
 
@@ -3,19 +3,58 @@ module hazard_detection_unit (
     input wire [4:0] rs2_index_decode,      // RS2 address in ID stage
     input wire [4:0] rd_index_execute,       // RD address in EX stage
     input wire memory_read_enable_execute,       // MemRead signal in EX stage (is it a Load?)
+    input wire [4:0] rd_index_decode,       // RD address in ID stage
+    input wire register_write_enable_decode,    // ID instruction writes rd
+    input wire [31:0] pending_registers,    // Scoreboard: registers waiting for an MDU result
+
+    // Second issue slot (dual issue): the instruction after the ID instruction
+    input wire [4:0] rs1_index_second,
+    input wire [4:0] rs2_index_second,
+    input wire [4:0] rd_index_second,
+    input wire register_write_enable_second,
     
-    output reg stall_pipeline              // Stall signal (1 = stall, 0 = normal)
+    output reg stall_pipeline,             // Stall signal (1 = stall, 0 = normal)
+    output reg stall_load_use,             // The stall is a load-use hazard (not the MDU scoreboard)
+    output reg stall_second                // The second instruction cannot issue alongside the first
 );
 
     always @(*) begin
         // Load-Use Hazard Detection
         // If instruction in EX is a Load, and its destination (rd_index_execute) matches
         // either source register (rs1_index_decode, rs2_index_decode) in ID stage, we must stall.
+        stall_load_use = 1'b0;
         if (memory_read_enable_execute && (rd_index_execute != 0) && ((rd_index_execute == rs1_index_decode) || (rd_index_execute == rs2_index_decode))) begin
             stall_pipeline = 1'b1;
+            stall_load_use = 1'b1;
+        // Scoreboard Hazard: the ID instruction reads a register an MDU operation has not
+        // written back yet, or would write it first (the late MDU write must not win)
+        end else if (pending_registers[rs1_index_decode] || pending_registers[rs2_index_decode] ||
+                     (register_write_enable_decode && pending_registers[rd_index_decode])) begin
+            stall_pipeline = 1'b1;
         end else begin
             stall_pipeline = 1'b0;
         end
     end
 
+    // Pairing Hazards: the second instruction waits to issue on its own (as the next ID
+    // instruction) when it reads or writes the first one's rd (no bypass within a pair;
+    // this also keeps a late MDU write from landing after it), reads a load in EX, or
+    // touches a register pending in the scoreboard
+    wire writes_first = register_write_enable_decode && (rd_index_decode != 0);
+
+    always @(*) begin
+        if (writes_first && ((rd_index_decode == rs1_index_second) || (rd_index_decode == rs2_index_second) ||
+                             (register_write_enable_second && rd_index_decode == rd_index_second))) begin
+            stall_second = 1'b1;
+        end else if (memory_read_enable_execute && (rd_index_execute != 0) &&
+                     ((rd_index_execute == rs1_index_second) || (rd_index_execute == rs2_index_second))) begin
+            stall_second = 1'b1;
+        end else if (pending_registers[rs1_index_second] || pending_registers[rs2_index_second] ||
+                     (register_write_enable_second && pending_registers[rd_index_second])) begin
+            stall_second = 1'b1;
+        end else begin
+            stall_second = 1'b0;
+        end
+    end
+
 endmodule
@@ -1,17 +1,23 @@
 module mdu (
     input wire clk,
     input wire rst_n,
-    
+
     input wire start,              // Start signal from Control Unit
     input wire [2:0] operation,    // funct3 from instruction
     input wire [31:0] operand_a,
     input wire [31:0] operand_b,
-    
-    output reg busy,               // MDU is working, stall pipeline
-    output reg ready,              // Result is ready
-    output reg [31:0] result
+    input wire [4:0] tag,          // Carried with the operation (destination register)
+
+    output reg busy,               // Divider is working
+    output wire ready,             // Result is ready
+    output wire [31:0] result,
+    output wire [4:0] result_tag   // Tag of the operation whose result is ready
 );
 
+    // Multiplier pipeline depth: 0 = combinational (result in the start cycle),
+    // 1..3 = registered stages; a new multiply can start every cycle
+    parameter MUL_LATENCY = 1;
+
     // Operations
     localparam OP_MUL    = 3'b000;
     localparam OP_MULH   = 3'b001;
@@ -27,174 +33,252 @@ module mdu (
     localparam STATE_WORK = 2'b01;
     localparam STATE_DONE = 2'b10;
 
+    wire is_mul_op = (operation[2] == 1'b0);
+    wire is_div_op = (operation[2] == 1'b1);
+
+    // =========================================================================
+    // Multiplier: 33x33 signed product, operands sign- or zero-extended per op
+    // =========================================================================
+    wire mul_start = start && is_mul_op;
+    wire mul_sign_a = (operation == OP_MULH) || (operation == OP_MULHSU);
+    wire mul_sign_b = (operation == OP_MULH);
+    wire signed [32:0] mul_a = {mul_sign_a && operand_a[31], operand_a};
+    wire signed [32:0] mul_b = {mul_sign_b && operand_b[31], operand_b};
+    wire mul_high = (operation != OP_MUL);
+
+    // Stage 1 (MUL_LATENCY >= 2): operands
+    reg        s1_valid;
+    reg        s1_high;
+    reg [4:0]  s1_tag;
+    reg signed [32:0] s1_a;
+    reg signed [32:0] s1_b;
+
+    wire        m1_valid = (MUL_LATENCY >= 2) ? s1_valid : mul_start;
+    wire        m1_high  = (MUL_LATENCY >= 2) ? s1_high  : mul_high;
+    wire [4:0]  m1_tag   = (MUL_LATENCY >= 2) ? s1_tag   : tag;
+    wire signed [32:0] m1_a = (MUL_LATENCY >= 2) ? s1_a : mul_a;
+    wire signed [32:0] m1_b = (MUL_LATENCY >= 2) ? s1_b : mul_b;
+
+    // Partial products: a * b[15:0] (unsigned) and a * b[32:16] (signed)
+    wire signed [49:0] pp_low  = m1_a * $signed({1'b0, m1_b[15:0]});
+    wire signed [49:0] pp_high = m1_a * $signed(m1_b[32:16]);
+
+    // Stage 2 (MUL_LATENCY >= 3): partial products
+    reg        s2_valid;
+    reg        s2_high;
+    reg [4:0]  s2_tag;
+    reg signed [49:0] s2_pp_low;
+    reg signed [49:0] s2_pp_high;
+
+    wire        m2_valid = (MUL_LATENCY >= 3) ? s2_valid : m1_valid;
+    wire        m2_high  = (MUL_LATENCY >= 3) ? s2_high  : m1_high;
+    wire [4:0]  m2_tag   = (MUL_LATENCY >= 3) ? s2_tag   : m1_tag;
+    wire signed [49:0] m2_pp_low  = (MUL_LATENCY >= 3) ? s2_pp_low  : pp_low;
+    wire signed [49:0] m2_pp_high = (MUL_LATENCY >= 3) ? s2_pp_high : pp_high;
+
+    wire signed [65:0] product = ($signed({{16{m2_pp_high[49]}}, m2_pp_high}) <<< 16) +
+                                 $signed({{16{m2_pp_low[49]}}, m2_pp_low});
+    wire [31:0] product_select = m2_high ? product[63:32] : product[31:0];
+
+    // Stage 3 (MUL_LATENCY >= 1): result
+    reg        s3_valid;
+    reg [31:0] s3_result;
+    reg [4:0]  s3_tag;
+
+    wire        mul_ready  = (MUL_LATENCY >= 1) ? s3_valid  : m2_valid;
+    wire [31:0] mul_result = (MUL_LATENCY >= 1) ? s3_result : product_select;
+    wire [4:0]  mul_tag    = (MUL_LATENCY >= 1) ? s3_tag    : m2_tag;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s1_valid <= 0;
+            s1_high <= 0;
+            s1_tag <= 0;
+            s1_a <= 0;
+            s1_b <= 0;
+            s2_valid <= 0;
+            s2_high <= 0;
+            s2_tag <= 0;
+            s2_pp_low <= 0;
+            s2_pp_high <= 0;
+            s3_valid <= 0;
+            s3_result <= 0;
+            s3_tag <= 0;
+        end else begin
+            s1_valid <= mul_start;
+            s1_high <= mul_high;
+            s1_tag <= tag;
+            s1_a <= mul_a;
+            s1_b <= mul_b;
+            s2_valid <= m1_valid;
+            s2_high <= m1_high;
+            s2_tag <= m1_tag;
+            s2_pp_low <= pp_low;
+            s2_pp_high <= pp_high;
+            s3_valid <= m2_valid;
+            s3_result <= product_select;
+            s3_tag <= m2_tag;
+        end
+    end
+
+    // =========================================================================
+    // Divider: radix-4 restoring, two quotient bits per cycle. Only as many
+    // steps as the quotient has bits; divide by zero and signed overflow
+    // resolve in the start cycle.
+    // =========================================================================
     reg [1:0] state;
-    reg [5:0] count; // 0 to 32
-    
+    reg [4:0] count; // Remaining steps, 1 to 16
+    reg div_ready;
+    reg [31:0] div_result;
+    reg [4:0] div_tag;
+
     // Internal Registers for Calculation
-    reg [63:0] reg_pa; // Product/Remainder(High) + Multiplicand/Quotient(Low)
-    reg [31:0] reg_b;  // Divisor / Multiplier
-    reg sign_a;
-    reg sign_b;
-    reg is_div;
+    reg [63:0] reg_pa; // Remainder(High) + Dividend/Quotient(Low)
+    reg [31:0] reg_b;  // Divisor
+    reg [33:0] reg_b3; // 3 * Divisor
     reg is_rem;
     reg negate_result;
 
-    wire is_mul_op = (operation[2] == 1'b0);
-    wire is_div_op = (operation[2] == 1'b1);
+    // Number of significant bits (32 - leading zeros)
+    function [5:0] significant_bits;
+        input [31:0] value;
+        integer n;
+        begin
+            significant_bits = 0;
+            for (n = 0; n < 32; n = n + 1) begin
+                if (value[n]) significant_bits = n + 1;
+            end
+        end
+    endfunction
+
+    // Setup (start cycle)
+    wire div_signed = (operation == OP_DIV) || (operation == OP_REM);
+    wire div_is_rem = (operation == OP_REM) || (operation == OP_REMU);
+    wire [31:0] div_abs_a = (div_signed && operand_a[31]) ? (-operand_a) : operand_a;
+    wire [31:0] div_abs_b = (div_signed && operand_b[31]) ? (-operand_b) : operand_b;
+    wire div_by_zero = (operand_b == 0);
+    wire div_overflow = div_signed && (operand_a == 32'h80000000) && (operand_b == 32'hFFFFFFFF);
+
+    // The quotient has at most (dividend bits - divisor bits + 1) bits; the dividend is
+    // split so the remainder starts with the bits above them (already less than the divisor)
+    wire [5:0] div_a_bits = significant_bits(div_abs_a);
+    wire [5:0] div_b_bits = significant_bits(div_abs_b);
+    wire [5:0] div_quotient_bits = (div_a_bits >= div_b_bits) ? (div_a_bits - div_b_bits + 6'd1) : 6'd0;
+    wire [5:0] div_steps = (div_quotient_bits + 6'd1) >> 1;
+    wire [63:0] div_aligned = {32'b0, div_abs_a} << (6'd32 - {div_steps[4:0], 1'b0});
 
     // Temporary variables
-    reg sign_a_local;
-    reg sign_b_local;
-    reg [32:0] sum;
-    reg [63:0] shifted;
-    reg [32:0] diff;
-    reg [63:0] final_prod;
+    reg [33:0] partial;
+    reg [34:0] diff1;
+    reg [34:0] diff2;
+    reg [34:0] diff3;
     reg [31:0] final_val;
 
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             state <= STATE_IDLE;
             busy <= 0;
-            ready <= 0;
-            result <= 0;
+            div_ready <= 0;
+            div_result <= 0;
+            div_tag <= 0;
             count <= 0;
             reg_pa <= 0;
             reg_b <= 0;
-            sign_a <= 0;
-            sign_b <= 0;
-            is_div <= 0;
+            reg_b3 <= 0;
             is_rem <= 0;
             negate_result <= 0;
             // Initialize temps to avoid latches
-            sign_a_local = 0;
-            sign_b_local = 0;
-            sum = 0;
-            shifted = 0;
-            diff = 0;
-            final_prod = 0;
+            partial = 0;
+            diff1 = 0;
+            diff2 = 0;
+            diff3 = 0;
             final_val = 0;
         end else begin
             // Default assignments for temps to avoid latches
-            sign_a_local = 0;
-            sign_b_local = 0;
-            sum = 0;
-            shifted = 0;
-            diff = 0;
-            final_prod = 0;
+            partial = 0;
+            diff1 = 0;
+            diff2 = 0;
+            diff3 = 0;
             final_val = 0;
 
             case (state)
                 STATE_IDLE: begin
-                    ready <= 0;
-                    if (start) begin
-                        state <= STATE_WORK;
-                        busy <= 1;
-                        count <= 0;
-                        
-                        // Pre-processing
-                        is_div <= is_div_op;
-                        
-                        if (is_mul_op) begin
-                            if (operation == OP_MULH) begin
-                                sign_a_local = operand_a[31];
-                                sign_b_local = operand_b[31];
-                            end else if (operation == OP_MULHSU) begin
-                                sign_a_local = operand_a[31];
-                                sign_b_local = 0;
-                            end else if (operation == OP_MULHU) begin
-                                sign_a_local = 0;
-                                sign_b_local = 0;
-                            end else begin // MUL
-                                sign_a_local = 0; 
-                                sign_b_local = 0;
-                            end
-
-                            // Abs values
-                            reg_pa <= {32'b0, (sign_a_local && operand_a[31]) ? (-operand_a) : operand_a};
-                            reg_b  <= (sign_b_local && operand_b[31]) ? (-operand_b) : operand_b;
-                            
-                            // Determine result sign for High part
-                            negate_result <= sign_a_local ^ sign_b_local;
-                            
+                    div_ready <= 0;
+                    if (start && is_div_op) begin
+                        div_tag <= tag;
+                        if (div_by_zero) begin
+                            // Quotient all ones, remainder is the dividend
+                            div_ready <= 1;
+                            div_result <= div_is_rem ? operand_a : 32'hFFFFFFFF;
+                        end else if (div_overflow) begin
+                            // -2^31 / -1: quotient -2^31, remainder 0
+                            div_ready <= 1;
+                            div_result <= div_is_rem ? 32'h0 : 32'h80000000;
                         end else begin
-                            // Division Setup
-                            sign_a_local = (operation == OP_DIV || operation == OP_REM) ? operand_a[31] : 0;
-                            sign_b_local = (operation == OP_DIV || operation == OP_REM) ? operand_b[31] : 0;
-                            
-                            reg_pa <= {32'b0, (sign_a_local) ? (-operand_a) : operand_a};
-                            reg_b <= (sign_b_local) ? (-operand_b) : operand_b;
-                            
-                            if (operation == OP_REM || operation == OP_REMU) begin
-                                negate_result <= sign_a_local;
-                                is_rem <= 1;
+                            state <= (div_steps == 0) ? STATE_DONE : STATE_WORK;
+                            busy <= 1;
+                            count <= div_steps[4:0];
+
+                            reg_pa <= div_aligned;
+                            reg_b <= div_abs_b;
+                            reg_b3 <= {2'b0, div_abs_b} + {1'b0, div_abs_b, 1'b0};
+                            is_rem <= div_is_rem;
+
+                            if (div_is_rem) begin
+                                negate_result <= div_signed && operand_a[31];
                             end else begin
-                                negate_result <= sign_a_local ^ sign_b_local;
-                                is_rem <= 0;
+                                negate_result <= div_signed && (operand_a[31] ^ operand_b[31]);
                             end
                         end
                     end
                 end
 
                 STATE_WORK: begin
-                    count <= count + 1;
-                    
-                    if (is_mul_op) begin
-                        // Multiplication Step (Shift and Add)
-                        if (reg_pa[0]) begin
-                            sum = reg_pa[63:32] + reg_b;
-                        end else begin
-                            sum = {1'b0, reg_pa[63:32]};
-                        end
-                        reg_pa <= {sum, reg_pa[31:1]};
+                    count <= count - 1;
+
+                    // Division Step (Radix-4 Restoring): shift in two dividend bits,
+                    // subtract the largest multiple of the divisor that fits
+                    partial = reg_pa[63:30];
+                    diff3 = {1'b0, partial} - {1'b0, reg_b3};
+                    diff2 = {1'b0, partial} - {2'b0, reg_b, 1'b0};
+                    diff1 = {1'b0, partial} - {3'b0, reg_b};
+
+                    if (!diff3[34]) begin
+                        reg_pa <= {diff3[31:0], reg_pa[29:0], 2'b11};
+                    end else if (!diff2[34]) begin
+                        reg_pa <= {diff2[31:0], reg_pa[29:0], 2'b10};
+                    end else if (!diff1[34]) begin
+                        reg_pa <= {diff1[31:0], reg_pa[29:0], 2'b01};
                     end else begin
-                        // Division Step (Restoring)
-                        shifted = {reg_pa[62:0], 1'b0};
-                        diff = {1'b0, shifted[63:32]} - {1'b0, reg_b};
-                        
-                        if (diff[32]) begin // Negative result
-                            reg_pa <= shifted; // Q[0] remains 0
-                        end else begin // Positive result
-                            reg_pa <= {diff[31:0], shifted[31:1], 1'b1}; // Update P, set Q[0] = 1
-                        end
+                        reg_pa <= {partial[31:0], reg_pa[29:0], 2'b00};
                     end
 
-                    if (count == 31) begin
+                    if (count == 1) begin
                         state <= STATE_DONE;
                     end
                 end
 
                 STATE_DONE: begin
                     busy <= 0;
-                    ready <= 1;
+                    div_ready <= 1;
                     state <= STATE_IDLE;
-                    
-                    if (is_mul_op) begin
-                        final_prod = (negate_result) ? (-reg_pa) : reg_pa;
-                        
-                        case (operation)
-                            OP_MUL:    result <= final_prod[31:0];
-                            OP_MULH:   result <= final_prod[63:32];
-                            OP_MULHSU: result <= final_prod[63:32];
-                            OP_MULHU:  result <= reg_pa[63:32];
-                            default:   result <= final_prod[31:0];
-                        endcase
+
+                    if (is_rem) begin
+                        final_val = reg_pa[63:32];
                     end else begin
-                        if (is_rem) begin
-                            final_val = reg_pa[63:32];
-                        end else begin
-                            final_val = reg_pa[31:0];
-                        end
-                        
-                        if (reg_b == 0) begin
-                            if (is_rem) result <= operand_a;
-                            else result <= 32'hFFFFFFFF;
-                        end else begin
-                            result <= (negate_result) ? (-final_val) : final_val;
-                        end
+                        final_val = reg_pa[31:0];
                     end
+
+                    div_result <= (negate_result) ? (-final_val) : final_val;
                 end
             endcase
         end
     end
 
+    // At most one result per cycle: the caller starts a divide only with nothing
+    // in flight, and no multiply while a divide is running
+    assign ready = mul_ready || div_ready;
+    assign result = mul_ready ? mul_result : div_result;
+    assign result_tag = mul_ready ? mul_tag : div_tag;
+
 endmodule
@@ -1,42 +1,83 @@
 module regfile (
     input wire clk,
+    input wire [1:0] thread, // Running hardware context: selects the register bank for every port
     input wire write_enable,
     input wire [4:0] rs1_index,
     input wire [4:0] rs2_index,
     input wire [4:0] rd_index,
     input wire [31:0] write_data,
+    // Second write port (out-of-band MDU results); younger than the WB writes, wins on the same rd
+    input wire write_enable_2,
+    input wire [4:0] rd_index_2,
+    input wire [31:0] write_data_2,
+    // Third write port (WB of the second pipe); younger than the first WB write, wins on the same rd
+    input wire write_enable_3,
+    input wire [4:0] rd_index_3,
+    input wire [31:0] write_data_3,
     output wire [31:0] rs1_read_data,
-    output wire [31:0] rs2_read_data
+    output wire [31:0] rs2_read_data,
+    // Read ports 3 and 4 (operands of the second pipe)
+    input wire [4:0] rs3_index,
+    input wire [4:0] rs4_index,
+    output wire [31:0] rs3_read_data,
+    output wire [31:0] rs4_read_data
 );
 
-    // 32 registers of 32-bit width
-    reg [31:0] registers [0:31];
+    parameter THREADS = 1; // Hardware contexts, one bank of 32 registers each (1 to 4)
+
+    // 32 registers of 32-bit width per context; context t holds x0..x31 at 32*t..32*t+31
+    reg [31:0] registers [0:32*THREADS-1] /*verilator public_flat_rd*/;
 
     integer i;
 
     // Initialize registers to 0
     initial begin
-        for (i = 0; i < 32; i = i + 1) begin
+        for (i = 0; i < 32*THREADS; i = i + 1) begin
             registers[i] = 32'h0;
         end
-        registers[2] = 32'h02000000; // Initialize SP to 32MB
+        for (i = 0; i < THREADS; i = i + 1) begin
+            registers[32*i + 2] = 32'h02000000; // Initialize SP to 32MB
+        end
     end
 
     // Write operation (Synchronous)
     // Note: x0 is hardwired to 0, so we never write to it.
+    // Later assignments win: WB, then second-pipe WB, then MDU
     always @(posedge clk) begin
         if (write_enable && (rd_index != 5'b00000)) begin
-            registers[rd_index] <= write_data;
+            registers[{thread, rd_index}] <= write_data;
+        end
+        if (write_enable_3 && (rd_index_3 != 5'b00000)) begin
+            registers[{thread, rd_index_3}] <= write_data_3;
+        end
+        if (write_enable_2 && (rd_index_2 != 5'b00000)) begin
+            registers[{thread, rd_index_2}] <= write_data_2;
         end
     end
 
     // Read operation (Asynchronous) with Write-Through Forwarding
     assign rs1_read_data = (rs1_index == 5'b0) ? 32'b0 :
+                           (write_enable_2 && (rs1_index == rd_index_2)) ? write_data_2 : // Forwarding from port 2
+                           (write_enable_3 && (rs1_index == rd_index_3)) ? write_data_3 : // Forwarding from port 3
                            (write_enable && (rs1_index == rd_index)) ? write_data : // Forwarding from WB
-                           registers[rs1_index];
+                           registers[{thread, rs1_index}];
 
     assign rs2_read_data = (rs2_index == 5'b0) ? 32'b0 :
+                           (write_enable_2 && (rs2_index == rd_index_2)) ? write_data_2 : // Forwarding from port 2
+                           (write_enable_3 && (rs2_index == rd_index_3)) ? write_data_3 : // Forwarding from port 3
                            (write_enable && (rs2_index == rd_index)) ? write_data : // Forwarding from WB
-                           registers[rs2_index];
+                           registers[{thread, rs2_index}];
+
+    assign rs3_read_data = (rs3_index == 5'b0) ? 32'b0 :
+                           (write_enable_2 && (rs3_index == rd_index_2)) ? write_data_2 : // Forwarding from port 2
+                           (write_enable_3 && (rs3_index == rd_index_3)) ? write_data_3 : // Forwarding from port 3
+                           (write_enable && (rs3_index == rd_index)) ? write_data : // Forwarding from WB
+                           registers[{thread, rs3_index}];
+
+    assign rs4_read_data = (rs4_index == 5'b0) ? 32'b0 :
+                           (write_enable_2 && (rs4_index == rd_index_2)) ? write_data_2 : // Forwarding from port 2
+                           (write_enable_3 && (rs4_index == rd_index_3)) ? write_data_3 : // Forwarding from port 3
+                           (write_enable && (rs4_index == rd_index)) ? write_data : // Forwarding from WB
+                           registers[{thread, rs4_index}];
 
 endmodule
@@ -3,7 +3,9 @@ module core (
     input wire rst_n,
     input wire [31:0] hart_id, // Added: Hart ID
     input wire [31:0] instruction,   // Instruction from IMEM (IF stage)
-    input wire instruction_grant,      // Instruction Grant (Cache Hit/Ready)
+    input wire instruction_valid,      // Instruction valid this cycle (I-Cache hit or refill word)
+    input wire [31:0] second_instruction, // Dual fetch: the word after the PC
+    input wire second_instruction_valid,  // It is in the same I-Cache line (hit)
     output wire [31:0] program_counter_address, // PC output to IMEM
 
     // Bus Interface
@@ -12,11 +14,20 @@ module core (
     output wire [3:0]  bus_byte_enable,
     output wire        bus_write_enable,
     output wire        bus_read_enable,
+    output wire [31:0] bus_program_counter, // PC of the load/store on the bus
     input  wire [31:0] bus_read_data,
     input  wire        bus_busy,
-    input  wire        timer_interrupt_request
+    input  wire        timer_interrupt_request,
+    input  wire [2:0]  cache_miss_events, // Demand misses this cycle: {L2, D-Cache, I-Cache} (performance counters)
+    output wire        wait_for_interrupt // Parked on WFI (idle fast-forward)
 );
 
+    parameter MUL_LATENCY = 1; // MDU multiplier pipeline depth (0 = combinational)
+    parameter BRANCH_RESOLVE_DECODE = 0; // Resolve JAL, and conditional branches whose operands are ready, in ID
+    parameter FETCH_QUEUE_DEPTH = 1; // Fetch queue entries between IF and ID (1 = a plain IF/ID register)
+    parameter DUAL_ISSUE = 0; // Fetch and issue two instructions per cycle (second pipe ALU-only; needs FETCH_QUEUE_DEPTH >= 2)
+    parameter THREADS = 1; // Hardware contexts sharing the pipeline, switched on a load miss (1 to 4)
+
     // =========================================================================
     // Signal Declarations
     // =========================================================================
@@ -26,6 +37,8 @@ module core (
     wire flush_due_to_branch;
     wire flush_due_to_jump;
     wire flush_due_to_trap;
+    wire flush_due_to_branch_decode;
+    wire branch_taken_decode;
     wire [31:0] correct_pc;
     wire [31:0] trap_pc;
     wire pc_mux_select_trap;
@@ -34,6 +47,13 @@ module core (
     wire [31:0] if_id_instruction;
     wire if_id_prediction_taken;
     wire [31:0] if_id_prediction_target;
+    wire [31:0] if_id_prediction_history;
+
+    wire [31:0] if_id_second_program_counter;
+    wire [31:0] if_id_second_instruction;
+    wire if_id_second_prediction_taken;
+    wire if_id_second_valid;
+    wire issue_second;
 
     wire [31:0] id_ex_program_counter;
     wire branch_taken_execute;
@@ -42,20 +62,31 @@ module core (
     wire is_jump_execute;
     wire is_jalr_execute;
     wire [31:0] jalr_target_execute;
+    wire [31:0] prediction_history_execute;
+    wire [4:0] rd_index_execute;
+    wire [4:0] rs1_index_execute;
+    wire execute_advance;
 
     // =========================================================================
     // Frontend Instance
     // =========================================================================
-    frontend u_frontend (
+    frontend #(
+        .FETCH_QUEUE_DEPTH(FETCH_QUEUE_DEPTH),
+        .DUAL_ISSUE(DUAL_ISSUE)
+    ) u_frontend (
         .clk(clk),
         .rst_n(rst_n),
         .instruction(instruction),
-        .instruction_grant(instruction_grant),
+        .instruction_valid(instruction_valid),
+        .second_instruction(second_instruction),
+        .second_instruction_valid(second_instruction_valid),
         .program_counter_address(program_counter_address),
         .stall_backend(stall_pipeline),
         .flush_due_to_branch(flush_due_to_branch),
         .flush_due_to_jump(flush_due_to_jump),
         .flush_due_to_trap(flush_due_to_trap),
+        .flush_due_to_branch_decode(flush_due_to_branch_decode),
+        .branch_taken_decode(branch_taken_decode),
         .correct_pc(correct_pc),
         .trap_pc(trap_pc),
         .pc_mux_select_trap(pc_mux_select_trap),
@@ -66,17 +97,32 @@ module core (
         .is_jump_execute(is_jump_execute),
         .is_jalr_execute(is_jalr_execute),
         .jalr_target_execute(jalr_target_execute),
+        .prediction_history_execute(prediction_history_execute),
+        .rd_index_execute(rd_index_execute),
+        .rs1_index_execute(rs1_index_execute),
+        .execute_advance(execute_advance),
+        .issue_second(issue_second),
         .if_id_program_counter(if_id_program_counter),
         .if_id_instruction(if_id_instruction),
         .if_id_prediction_taken(if_id_prediction_taken),
-        .if_id_prediction_target(if_id_prediction_target)
+        .if_id_prediction_target(if_id_prediction_target),
+        .if_id_prediction_history(if_id_prediction_history),
+        .if_id_second_program_counter(if_id_second_program_counter),
+        .if_id_second_instruction(if_id_second_instruction),
+        .if_id_second_prediction_taken(if_id_second_prediction_taken),
+        .if_id_second_valid(if_id_second_valid)
     );
 
     // =========================================================================
     // Backend Instance
     // =========================================================================
 
-    backend u_backend (
+    backend #(
+        .MUL_LATENCY(MUL_LATENCY),
+        .BRANCH_RESOLVE_DECODE(BRANCH_RESOLVE_DECODE),
+        .DUAL_ISSUE(DUAL_ISSUE),
+        .THREADS(THREADS)
+    ) u_backend (
         .clk(clk),
         .rst_n(rst_n),
         .hart_id(hart_id), // Added: Hart ID
@@ -84,15 +130,22 @@ module core (
         .if_id_instruction(if_id_instruction),
         .if_id_prediction_taken(if_id_prediction_taken),
         .if_id_prediction_target(if_id_prediction_target),
-        .instruction_grant(instruction_grant),
+        .if_id_prediction_history(if_id_prediction_history),
+        .if_id_second_program_counter(if_id_second_program_counter),
+        .if_id_second_instruction(if_id_second_instruction),
+        .if_id_second_prediction_taken(if_id_second_prediction_taken),
+        .if_id_second_valid(if_id_second_valid),
+        .issue_second(issue_second),
         .bus_address(bus_address),
         .bus_write_data(bus_write_data),
         .bus_byte_enable(bus_byte_enable),
         .bus_write_enable(bus_write_enable),
         .bus_read_enable(bus_read_enable),
+        .bus_program_counter(bus_program_counter),
         .bus_read_data(bus_read_data),
         .bus_busy(bus_busy),
         .timer_interrupt_request(timer_interrupt_request),
+        .cache_miss_events(cache_miss_events),
         .stall_pipeline(stall_pipeline),
         .flush_due_to_branch(flush_due_to_branch),
         .flush_due_to_jump(flush_due_to_jump),
@@ -106,7 +159,14 @@ module core (
         .is_branch_execute(is_branch_execute),
         .is_jump_execute(is_jump_execute),
         .is_jalr_execute(is_jalr_execute),
-        .jalr_target_execute(jalr_target_execute)
+        .jalr_target_execute(jalr_target_execute),
+        .prediction_history_execute(prediction_history_execute),
+        .rd_index_execute(rd_index_execute),
+        .rs1_index_execute(rs1_index_execute),
+        .execute_advance(execute_advance),
+        .flush_due_to_branch_decode(flush_due_to_branch_decode),
+        .branch_taken_decode(branch_taken_decode),
+        .wait_for_interrupt(wait_for_interrupt)
     );
 
 endmodule
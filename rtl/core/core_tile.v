@@ -1,7 +1,7 @@
 module core_tile (
     input wire clk,
     input wire rst_n,
-    input wire [31:0] hart_id,
+    input wire [31:0] hart_id, // Of context 0; context t is hart hart_id + t
 
     // Bus Master Interface
     output wire [31:0] bus_addr,
@@ -9,32 +9,68 @@ module core_tile (
     output wire [3:0]  bus_be,
     output wire        bus_we,
     output wire        bus_req,
+    output wire        bus_burst, // 4-beat line-fill burst
+    output wire        bus_abort, // Ends the burst in flight early (a dropped instruction or data prefetch)
     input wire [31:0]  bus_rdata,
     input wire         bus_ready,
 
     // Interrupts
-    input wire         timer_irq
+    input wire         timer_irq,
+    output wire        wait_for_interrupt, // The core is parked on WFI
+
+    // Performance Counters
+    input wire         l2_miss // The shared L2 started a line fill for this tile's request
 );
 
+    // L1 Data Cache Configuration
+    parameter DCACHE_NUM_WAYS = 2;
+    parameter DCACHE_WRITE_BACK = 0; // Write-back needs coherent sharers; off for the SMP chip_top
+    parameter STORE_BUFFER_DEPTH = 4; // Posted stores in front of the D-Cache (0 = none)
+    parameter ICACHE_PREFETCH = 1; // Next-line instruction prefetch (0 = off)
+    parameter DCACHE_PREFETCH = 1; // Stride data prefetch (0 = off)
+
+    // Core Configuration
+    parameter MUL_LATENCY = 1; // MDU multiplier pipeline depth (0 = combinational, up to 3)
+    parameter BRANCH_RESOLVE_DECODE = 1; // Resolve JAL and conditional branches in ID when possible (0 = always in EX)
+    parameter FETCH_QUEUE_DEPTH = 4; // Fetch queue entries between IF and ID (1 = a plain IF/ID register)
+    parameter DUAL_ISSUE = 0; // Fetch and issue two instructions per cycle (second pipe ALU-only)
+    parameter THREADS = 1; // Hardware contexts sharing the core, switched on a load miss (1 to 4)
+
     // Internal Signals
     wire [31:0] pc_addr;
     wire [31:0] instruction;
     wire        icache_stall;
-    reg         instruction_grant_reg;
+    wire [31:0] second_instruction;
+    wire        second_instruction_valid;
     
     wire [31:0] core_bus_addr;
     wire [31:0] core_bus_wdata;
     wire [3:0]  core_bus_be;
     wire        core_bus_we;
     wire        core_bus_re;
+    wire [31:0] core_bus_pc;
     wire [31:0] core_bus_rdata;
+    wire        core_bus_busy;
+
+    // Store Buffer <-> D-Cache
+    wire [31:0] dcache_cpu_addr;
+    wire [31:0] dcache_cpu_wdata;
+    wire [3:0]  dcache_cpu_be;
+    wire        dcache_cpu_we;
+    wire        dcache_cpu_re;
+    wire [31:0] dcache_cpu_rdata;
     wire        dcache_stall;
 
     // I-Cache <-> Arbiter
     wire [31:0] icache_mem_addr;
     wire        icache_mem_req;
+    wire        icache_mem_burst;
+    wire        icache_mem_prefetch;
+    wire        icache_mem_abort;
+    wire        icache_mem_preempted;
     wire [31:0] icache_mem_rdata;
     wire        icache_mem_ready;
+    wire        icache_miss;
 
     // D-Cache <-> Arbiter
     wire [31:0] dcache_mem_addr;
@@ -42,25 +78,32 @@ module core_tile (
     wire [3:0]  dcache_mem_be;
     wire        dcache_mem_we;
     wire        dcache_mem_req;
+    wire        dcache_mem_burst;
+    wire        dcache_mem_abort;
     wire [31:0] dcache_mem_rdata;
     wire        dcache_mem_ready;
+    wire        dcache_miss;
 
-    // Break combinational loop: register the instruction_grant signal
-    always @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            instruction_grant_reg <= 1'b0; // Start with no grant, will update after reset
-        end else begin
-            instruction_grant_reg <= !icache_stall;
-        end
-    end
+    // Fetch handshake: the I-Cache answer depends only on the PC register, its own
+    // state and the memory response, never on the core's stall logic, so valid is
+    // used in the same cycle (no combinational loop, no registered dead cycle)
+    wire instruction_valid = !icache_stall;
 
     // Core Instance
-    core u_core (
+    core #(
+        .MUL_LATENCY(MUL_LATENCY),
+        .BRANCH_RESOLVE_DECODE(BRANCH_RESOLVE_DECODE),
+        .FETCH_QUEUE_DEPTH(FETCH_QUEUE_DEPTH),
+        .DUAL_ISSUE(DUAL_ISSUE),
+        .THREADS(THREADS)
+    ) u_core (
         .clk(clk),
         .rst_n(rst_n),
         .hart_id(hart_id),
         .instruction(instruction),
-        .instruction_grant(instruction_grant_reg), // Use registered signal
+        .instruction_valid(instruction_valid),
+        .second_instruction(second_instruction),
+        .second_instruction_valid(second_instruction_valid),
         .program_counter_address(pc_addr),
         
         // Data Interface (to D-Cache)
@@ -69,14 +112,19 @@ module core_tile (
         .bus_byte_enable(core_bus_be),
         .bus_write_enable(core_bus_we),
         .bus_read_enable(core_bus_re),
+        .bus_program_counter(core_bus_pc),
         .bus_read_data(core_bus_rdata),
-        .bus_busy(dcache_stall), // Stall when D-Cache is busy (miss or write-through)
+        .bus_busy(core_bus_busy), // Stall on load misses or a full store buffer
         
-        .timer_interrupt_request(timer_irq)
+        .timer_interrupt_request(timer_irq),
+        .cache_miss_events({l2_miss, dcache_miss, icache_miss}),
+        .wait_for_interrupt(wait_for_interrupt)
     );
 
     // Instruction Cache
-    l1_inst_cache u_icache (
+    l1_inst_cache #(
+        .PREFETCH_ENABLE(ICACHE_PREFETCH)
+    ) u_icache (
         .clk(clk),
         .rst_n(rst_n),
         .hart_id(hart_id),
@@ -84,24 +132,72 @@ module core_tile (
         .program_counter_address(pc_addr),
         .instruction(instruction),
         .stall_cpu(icache_stall),
+        .second_instruction(second_instruction),
+        .second_instruction_valid(second_instruction_valid),
         // Memory Interface (to Arbiter)
         .instruction_memory_address(icache_mem_addr),
         .instruction_memory_request(icache_mem_req),
+        .instruction_memory_burst(icache_mem_burst),
+        .instruction_memory_prefetch(icache_mem_prefetch),
+        .instruction_memory_abort(icache_mem_abort),
+        .instruction_memory_preempted(icache_mem_preempted),
         .instruction_memory_read_data(icache_mem_rdata),
-        .instruction_memory_ready(icache_mem_ready)
+        .instruction_memory_ready(icache_mem_ready),
+        .demand_miss(icache_miss)
     );
 
+    // Store Buffer: stores retire in one cycle and drain to the D-Cache in the background
+    generate
+        if (STORE_BUFFER_DEPTH > 0) begin : g_store_buffer
+            store_buffer #(
+                .DEPTH(STORE_BUFFER_DEPTH)
+            ) u_store_buffer (
+                .clk(clk),
+                .rst_n(rst_n),
+                // CPU Interface
+                .cpu_address(core_bus_addr),
+                .cpu_write_data(core_bus_wdata),
+                .cpu_byte_enable(core_bus_be),
+                .cpu_write_enable(core_bus_we),
+                .cpu_read_enable(core_bus_re),
+                .cpu_read_data(core_bus_rdata),
+                .stall_cpu(core_bus_busy),
+                // Cache Interface
+                .cache_address(dcache_cpu_addr),
+                .cache_write_data(dcache_cpu_wdata),
+                .cache_byte_enable(dcache_cpu_be),
+                .cache_write_enable(dcache_cpu_we),
+                .cache_read_enable(dcache_cpu_re),
+                .cache_read_data(dcache_cpu_rdata),
+                .cache_stall(dcache_stall)
+            );
+        end else begin : g_no_store_buffer
+            assign dcache_cpu_addr = core_bus_addr;
+            assign dcache_cpu_wdata = core_bus_wdata;
+            assign dcache_cpu_be = core_bus_be;
+            assign dcache_cpu_we = core_bus_we;
+            assign dcache_cpu_re = core_bus_re;
+            assign core_bus_rdata = dcache_cpu_rdata;
+            assign core_bus_busy = dcache_stall;
+        end
+    endgenerate
+
     // Data Cache
-    l1_data_cache u_dcache (
+    l1_data_cache #(
+        .NUM_WAYS(DCACHE_NUM_WAYS),
+        .WRITE_BACK(DCACHE_WRITE_BACK),
+        .PREFETCH_ENABLE(DCACHE_PREFETCH)
+    ) u_dcache (
         .clk(clk),
         .rst_n(rst_n),
         // CPU Interface
-        .cpu_address(core_bus_addr),
-        .cpu_write_data(core_bus_wdata),
-        .cpu_byte_enable(core_bus_be),
-        .cpu_write_enable(core_bus_we),
-        .cpu_read_enable(core_bus_re),
-        .cpu_read_data(core_bus_rdata),
+        .cpu_address(dcache_cpu_addr),
+        .cpu_program_counter(core_bus_pc), // Loads reach the cache in their own MEM cycle
+        .cpu_write_data(dcache_cpu_wdata),
+        .cpu_byte_enable(dcache_cpu_be),
+        .cpu_write_enable(dcache_cpu_we),
+        .cpu_read_enable(dcache_cpu_re),
+        .cpu_read_data(dcache_cpu_rdata),
         .stall_cpu(dcache_stall),
         // Memory Interface (to Arbiter)
         .mem_address(dcache_mem_addr),
@@ -109,8 +205,11 @@ module core_tile (
         .mem_byte_enable(dcache_mem_be),
         .mem_write_enable(dcache_mem_we),
         .mem_request(dcache_mem_req),
+        .mem_burst(dcache_mem_burst),
+        .mem_abort(dcache_mem_abort),
         .mem_read_data(dcache_mem_rdata),
-        .mem_ready(dcache_mem_ready)
+        .mem_ready(dcache_mem_ready),
+        .demand_miss(dcache_miss)
     );
 
     // L1 Arbiter
@@ -121,8 +220,12 @@ module core_tile (
         // I-Cache Port
         .icache_addr(icache_mem_addr),
         .icache_req(icache_mem_req),
+        .icache_burst(icache_mem_burst),
+        .icache_prefetch(icache_mem_prefetch),
+        .icache_abort(icache_mem_abort),
         .icache_rdata(icache_mem_rdata),
         .icache_ready(icache_mem_ready),
+        .icache_preempted(icache_mem_preempted),
         
         // D-Cache Port
         .dcache_addr(dcache_mem_addr),
@@ -130,6 +233,8 @@ module core_tile (
         .dcache_be(dcache_mem_be),
         .dcache_we(dcache_mem_we),
         .dcache_req(dcache_mem_req),
+        .dcache_burst(dcache_mem_burst),
+        .dcache_abort(dcache_mem_abort),
         .dcache_rdata(dcache_mem_rdata),
         .dcache_ready(dcache_mem_ready),
         
@@ -139,6 +244,8 @@ module core_tile (
         .m_be(bus_be),
         .m_we(bus_we),
         .m_req(bus_req),
+        .m_burst(bus_burst),
+        .m_abort(bus_abort),
         .m_rdata(bus_rdata),
         .m_ready(bus_ready)
     );
@@ -1,70 +1,160 @@
 module branch_predictor (
     input wire clk,
     input wire rst_n,
-    
+
     // IF Stage: Prediction
     input wire [31:0] program_counter_fetch,
+    input wire [31:0] instruction_fetch,   // Fetched instruction (static prediction on a BTB miss)
     output wire prediction_taken,
     output wire [31:0] prediction_target,
-    
+    output wire [31:0] prediction_history, // Global history used for this prediction (carried to EX)
+    input wire fetch_advance,              // The fetched instruction enters IF/ID this cycle
+
     // EX Stage: Update
     input wire [31:0] program_counter_execute,          // PC of the branch instruction in EX
     input wire branch_taken_execute,       // Actual outcome (Taken/Not Taken)
     input wire [31:0] branch_target_execute, // Actual target address
     input wire is_branch_execute,          // Is it a branch instruction
-    input wire is_jump_execute             // Is it a jump instruction (JAL)
+    input wire is_jump_execute,            // Is it a jump instruction (JAL)
+    input wire [31:0] history_execute,     // Global history the EX instruction was predicted with
+    input wire mispredict_execute,         // EX redirects the fetch (history is repaired)
+
+    // ID Stage: early branch resolution
+    input wire [31:0] history_decode,      // Global history the ID instruction was predicted with
+    input wire is_branch_decode,           // The ID redirect is a conditional branch (otherwise JAL)
+    input wire branch_taken_decode,        // Its outcome
+    input wire mispredict_decode,          // ID redirects the fetch (history is repaired)
+
+    // Backend flush (trap entry, MRET, interrupt, thread switch)
+    input wire execute_advance,            // The EX instruction moves on to MEM this cycle
+    input wire restore                     // Restart the history from the committed copy
 );
 
-    // Simple BTB (Branch Target Buffer) + BHT (Branch History Table)
+    // BTB (Branch Target Buffer): target source for branches and jumps
     // Direct Mapped
     parameter ENTRIES = 64;
     parameter INDEX_BITS = 6; // log2(ENTRIES)
-    
+
+    // Gshare direction predictor: 2-bit counters indexed by PC xor global history
+    parameter PHT_ENTRIES = 256;
+    parameter PHT_INDEX_BITS = 8; // log2(PHT_ENTRIES)
+    parameter HISTORY_BITS = 8; // Global history length, at most PHT_INDEX_BITS (0 = bimodal)
+
+    // Static prediction for conditional branches that miss in the BTB:
+    // backward taken, forward not taken (0 = always not taken)
+    parameter STATIC_PREDICTION = 1;
+
+    localparam [31:0] HISTORY_MASK = (32'd1 << HISTORY_BITS) - 1;
+
     reg [31:0] btb_tag [0:ENTRIES-1];
     reg [31:0] btb_target [0:ENTRIES-1];
-    reg [1:0]  bht [0:ENTRIES-1]; // 2-bit saturating counter
+    reg        btb_conditional [0:ENTRIES-1]; // Conditional branch (direction from the PHT) vs jump
     reg        valid [0:ENTRIES-1];
-    
+    reg [1:0]  pht [0:PHT_ENTRIES-1]; // 2-bit saturating counter
+
+    // Speculative global history: shifted at fetch by every predecoded conditional branch, BTB hit or not,
+    // so it matches the committed and repaired histories built from every executed branch; restored from the mispredicted instruction's own snapshot when EX or ID redirects
+    reg [31:0] global_history;
+
+    // Committed history: the repaired history after the last conditional branch that left EX.
+    // A backend flush discards every younger fetch, so the speculative history restarts from it.
+    reg [31:0] committed_history;
+
     // -------------------------------------------------------------------------
     // Prediction Logic (IF Stage)
     // -------------------------------------------------------------------------
     wire [INDEX_BITS-1:0] index_if = program_counter_fetch[INDEX_BITS+1:2];
     wire [31:0] tag_if = program_counter_fetch;
-    
+
     wire entry_valid = valid[index_if];
     wire tag_match = (btb_tag[index_if] == tag_if);
-    wire [1:0] history = bht[index_if];
-    
-    // Predict taken if entry exists, tag matches, and counter >= 2 (Weakly Taken)
-    assign prediction_taken = entry_valid && tag_match && (history >= 2'b10);
-    assign prediction_target = btb_target[index_if];
-    
+    wire btb_hit = entry_valid && tag_match;
+
+    // Predecode for the static prediction: a branch with a negative offset jumps backward
+    wire static_branch_if = (instruction_fetch[6:0] == 7'b1100011);
+    wire [31:0] static_offset_if = {{20{instruction_fetch[31]}}, instruction_fetch[7],
+                                    instruction_fetch[30:25], instruction_fetch[11:8], 1'b0};
+    wire static_taken_if = (STATIC_PREDICTION != 0) && !btb_hit && static_branch_if && instruction_fetch[31];
+
+    wire [31:0] history_if = global_history & HISTORY_MASK;
+    wire [PHT_INDEX_BITS-1:0] pht_index_if = program_counter_fetch[PHT_INDEX_BITS+1:2] ^ history_if[PHT_INDEX_BITS-1:0];
+    wire [1:0] counter = pht[pht_index_if];
+
+    // Predict taken if entry exists, tag matches, and it is a jump or its counter >= 2 (Weakly Taken).
+    // On a miss, a backward branch is predicted taken to its own target.
+    assign prediction_taken = (btb_hit && (!btb_conditional[index_if] || (counter >= 2'b10))) || static_taken_if;
+    assign prediction_target = btb_hit ? btb_target[index_if] : (program_counter_fetch + static_offset_if);
+    assign prediction_history = history_if;
+
     // -------------------------------------------------------------------------
     // Update Logic (EX Stage)
     // -------------------------------------------------------------------------
     wire [INDEX_BITS-1:0] index_ex = program_counter_execute[INDEX_BITS+1:2];
-    
+    wire [31:0] history_ex = history_execute & HISTORY_MASK;
+    wire [PHT_INDEX_BITS-1:0] pht_index_ex = program_counter_execute[PHT_INDEX_BITS+1:2] ^ history_ex[PHT_INDEX_BITS-1:0];
+    wire [31:0] history_id = history_decode & HISTORY_MASK;
+
+    // Committed history including the branch leaving EX this cycle (restore source)
+    wire [31:0] committed_history_next = (execute_advance && is_branch_execute) ?
+                                         {history_ex[30:0], branch_taken_execute} : committed_history;
+
     integer i;
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             for (i = 0; i < ENTRIES; i = i + 1) begin
                 valid[i] <= 0;
-                bht[i] <= 2'b01; // Weakly Not Taken
+                btb_conditional[i] <= 0;
             end
         end else if (is_branch_execute || is_jump_execute) begin
-            // Update BTB/BHT
+            // Update BTB
             valid[index_ex] <= 1'b1;
             btb_tag[index_ex] <= program_counter_execute;
             btb_target[index_ex] <= branch_target_execute;
-            
+            btb_conditional[index_ex] <= is_branch_execute;
+        end
+    end
+
+    integer p;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            for (p = 0; p < PHT_ENTRIES; p = p + 1) begin
+                pht[p] <= 2'b01; // Weakly Not Taken
+            end
+        end else if (is_branch_execute) begin
+            // Train the counter the prediction was read from
             if (branch_taken_execute) begin
-                if (bht[index_ex] != 2'b11)
-                    bht[index_ex] <= bht[index_ex] + 1;
+                if (pht[pht_index_ex] != 2'b11)
+                    pht[pht_index_ex] <= pht[pht_index_ex] + 1;
             end else begin
-                if (bht[index_ex] != 2'b00)
-                    bht[index_ex] <= bht[index_ex] - 1;
+                if (pht[pht_index_ex] != 2'b00)
+                    pht[pht_index_ex] <= pht[pht_index_ex] - 1;
             end
         end
     end
 
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            committed_history <= 0;
+        end else begin
+            committed_history <= committed_history_next;
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            global_history <= 0;
+        end else if (restore) begin
+            // A flush fetches from trap_pc, ahead of any redirect in the same cycle
+            global_history <= committed_history_next;
+        end else if (mispredict_execute) begin
+            // Repair: history before the redirecting instruction, plus its real outcome if it is a branch
+            global_history <= is_branch_execute ? {history_ex[30:0], branch_taken_execute} : history_ex;
+        end else if (mispredict_decode) begin
+            // Same repair for a branch or JAL redirected from ID; the older EX redirect wins above
+            global_history <= is_branch_decode ? {history_id[30:0], branch_taken_decode} : history_id;
+        end else if (fetch_advance && static_branch_if) begin
+            global_history <= {global_history[30:0], prediction_taken};
+        end
+    end
+
 endmodule
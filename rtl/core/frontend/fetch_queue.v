@@ -0,0 +1,152 @@
+module fetch_queue (
+    input wire clk,
+    input wire rst_n,
+
+    // IF Stage: fetched instructions enter at the tail
+    input wire push,
+    input wire [31:0] push_program_counter,
+    input wire [31:0] push_instruction,
+    input wire push_prediction_taken,
+    input wire [31:0] push_prediction_target,
+    input wire [31:0] push_prediction_history,
+    output wire push_ready,     // An entry is free, or the head leaves this cycle
+
+    // Second fetch slot (dual issue): the next sequential instruction, pushed behind the first.
+    // It is never a control transfer and carries no prediction.
+    input wire push_second,
+    input wire [31:0] push_second_program_counter,
+    input wire [31:0] push_second_instruction,
+    output wire push_second_ready, // Room for both pushes
+
+    // ID Stage: the head is the instruction being decoded
+    input wire pop,             // The backend takes the head this cycle
+    output wire [31:0] head_program_counter,
+    output wire [31:0] head_instruction,
+    output wire head_prediction_taken,
+    output wire [31:0] head_prediction_target,
+    output wire [31:0] head_prediction_history,
+    output wire empty,
+
+    // Second issue slot (dual issue): the entry behind the head
+    input wire pop_second,      // The backend also takes the second entry this cycle
+    output wire [31:0] second_program_counter,
+    output wire [31:0] second_instruction,
+    output wire second_prediction_taken,
+    output wire second_valid,
+
+    // Flush: drop every entry (redirect or trap)
+    input wire flush
+);
+
+    // Instruction fetch queue: decouples fetch from backend stalls. The frontend
+    // keeps fetching ahead while the backend waits, and the backend drains the
+    // queue while the frontend waits for the I-Cache.
+
+    // Parameters
+    parameter DEPTH = 4; // Number of entries (1 = a plain IF/ID register)
+
+    localparam PTR_BITS = (DEPTH > 1) ? $clog2(DEPTH) : 1;
+
+    // Entry Storage
+    reg [31:0] entry_program_counter [0:DEPTH-1];
+    reg [31:0] entry_instruction [0:DEPTH-1];
+    reg        entry_prediction_taken [0:DEPTH-1];
+    reg [31:0] entry_prediction_target [0:DEPTH-1];
+    reg [31:0] entry_prediction_history [0:DEPTH-1];
+
+    reg [PTR_BITS-1:0] head; // Oldest entry (in ID)
+    reg [PTR_BITS-1:0] tail; // Next free slot
+    reg [PTR_BITS:0]   count;
+
+    assign empty = (count == 0);
+    assign second_valid = (count >= 2);
+
+    wire dequeue = pop && !empty;
+    wire dequeue_second = dequeue && pop_second && second_valid;
+
+    // Free entries after this cycle's pops
+    wire [31:0] space = DEPTH - count + (dequeue ? 1 : 0) + (dequeue_second ? 1 : 0);
+
+    wire enqueue = push && (space >= 1);
+    wire enqueue_second = enqueue && push_second && (space >= 2);
+
+    assign push_ready = (space >= 1);
+    assign push_second_ready = (space >= 2);
+
+    wire [PTR_BITS-1:0] head_next = (head == DEPTH - 1) ? 0 : head + 1;
+    wire [PTR_BITS-1:0] head_after_second = (head_next == DEPTH - 1) ? 0 : head_next + 1;
+    wire [PTR_BITS-1:0] tail_next = (tail == DEPTH - 1) ? 0 : tail + 1;
+    wire [PTR_BITS-1:0] tail_after_second = (tail_next == DEPTH - 1) ? 0 : tail_next + 1;
+
+    // An empty queue presents a bubble (instruction 0 decodes to no operation)
+    assign head_program_counter = empty ? 32'b0 : entry_program_counter[head];
+    assign head_instruction = empty ? 32'b0 : entry_instruction[head];
+    assign head_prediction_taken = !empty && entry_prediction_taken[head];
+    assign head_prediction_target = empty ? 32'b0 : entry_prediction_target[head];
+    assign head_prediction_history = empty ? 32'b0 : entry_prediction_history[head];
+
+    assign second_program_counter = second_valid ? entry_program_counter[head_next] : 32'b0;
+    assign second_instruction = second_valid ? entry_instruction[head_next] : 32'b0;
+    assign second_prediction_taken = second_valid && entry_prediction_taken[head_next];
+
+    // Statistics: cycles the backend held a waiting instruction, and cycles it found the queue empty
+    reg [31:0] backend_stall_cycles;
+    reg [31:0] empty_cycles;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            head <= 0;
+            tail <= 0;
+            count <= 0;
+            backend_stall_cycles <= 0;
+            empty_cycles <= 0;
+        end else if (flush) begin
+            head <= 0;
+            tail <= 0;
+            count <= 0;
+        end else begin
+            if (enqueue) begin
+                entry_program_counter[tail] <= push_program_counter;
+                entry_instruction[tail] <= push_instruction;
+                entry_prediction_taken[tail] <= push_prediction_taken;
+                entry_prediction_target[tail] <= push_prediction_target;
+                entry_prediction_history[tail] <= push_prediction_history;
+                tail <= tail_next;
+            end
+
+            if (enqueue_second) begin
+                entry_program_counter[tail_next] <= push_second_program_counter;
+                entry_instruction[tail_next] <= push_second_instruction;
+                entry_prediction_taken[tail_next] <= 1'b0;
+                entry_prediction_target[tail_next] <= 32'b0;
+                entry_prediction_history[tail_next] <= push_prediction_history;
+                tail <= tail_after_second;
+            end
+
+            if (dequeue_second) begin
+                head <= head_after_second;
+            end else if (dequeue) begin
+                head <= head_next;
+            end
+
+            count <= count + (enqueue ? 1 : 0) + (enqueue_second ? 1 : 0)
+                           - (dequeue ? 1 : 0) - (dequeue_second ? 1 : 0);
+
+            if (!empty && !pop) backend_stall_cycles <= backend_stall_cycles + 1;
+            if (empty && pop) empty_cycles <= empty_cycles + 1;
+        end
+    end
+
+    // Initialization for simulation
+    integer i;
+    initial begin
+        for (i = 0; i < DEPTH; i = i + 1) begin
+            entry_program_counter[i] = 0;
+            entry_instruction[i] = 0;
+            entry_prediction_taken[i] = 0;
+            entry_prediction_target[i] = 0;
+            entry_prediction_history[i] = 0;
+        end
+    end
+
+endmodule
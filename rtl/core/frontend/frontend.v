@@ -4,14 +4,18 @@ module frontend (
 
     // I-Cache Interface
     input wire [31:0] instruction,
-    input wire instruction_grant,
+    input wire instruction_valid, // The I-Cache presents the instruction at the PC this cycle
+    input wire [31:0] second_instruction, // Dual fetch: the word after the PC
+    input wire second_instruction_valid,
     output wire [31:0] program_counter_address,
 
     // Backend Control / Feedback
     input wire stall_backend, // Stall from Backend (Hazard)
     input wire flush_due_to_branch,
-    input wire flush_due_to_jump,
+    input wire flush_due_to_jump,          // JAL resolved in ID redirects (correct_pc)
     input wire flush_due_to_trap,
+    input wire flush_due_to_branch_decode, // Branch resolved in ID redirects (correct_pc)
+    input wire branch_taken_decode,        // Its outcome (history repair)
     input wire [31:0] correct_pc, // For mispredict recovery
     input wire [31:0] trap_pc,    // For traps/returns
     input wire pc_mux_select_trap, // Select trap_pc
@@ -24,14 +28,29 @@ module frontend (
     input wire is_jump_execute,
     input wire is_jalr_execute,
     input wire [31:0] jalr_target_execute,
+    input wire [31:0] prediction_history_execute, // History the EX branch was predicted with
+    input wire [4:0] rd_index_execute,
+    input wire [4:0] rs1_index_execute,
+    input wire execute_advance,
+    input wire issue_second,  // The backend issues the second queue entry alongside the head
 
-    // Outputs to Backend (IF/ID Pipeline Register)
-    output reg [31:0] if_id_program_counter,
-    output reg [31:0] if_id_instruction,
-    output reg if_id_prediction_taken,
-    output reg [31:0] if_id_prediction_target
+    // Outputs to Backend (IF/ID: head of the fetch queue)
+    output wire [31:0] if_id_program_counter,
+    output wire [31:0] if_id_instruction,
+    output wire if_id_prediction_taken,
+    output wire [31:0] if_id_prediction_target,
+    output wire [31:0] if_id_prediction_history,
+
+    // Second issue slot (dual issue): the entry behind the head
+    output wire [31:0] if_id_second_program_counter,
+    output wire [31:0] if_id_second_instruction,
+    output wire if_id_second_prediction_taken,
+    output wire if_id_second_valid
 );
 
+    parameter FETCH_QUEUE_DEPTH = 1; // Fetch queue entries between IF and ID (1 = a plain IF/ID register)
+    parameter DUAL_ISSUE = 0; // Fetch two sequential instructions per cycle (needs FETCH_QUEUE_DEPTH >= 2)
+
     // =========================================================================
     // Signal Declarations
     // =========================================================================
@@ -43,10 +62,34 @@ module frontend (
     // Branch Prediction Signals
     wire prediction_taken;
     wire [31:0] prediction_target;
+    wire [31:0] prediction_history;
+
+    // Return Address Stack Signals (overrides the BTB for returns)
+    wire ras_predict_return;
+    wire [31:0] ras_return_target;
+    wire predicted_taken = ras_predict_return || prediction_taken;
+    wire [31:0] predicted_target = ras_predict_return ? ras_return_target : prediction_target;
+
+    // Redirects from the backend select correct_pc
+    wire redirect_decode = flush_due_to_branch_decode || flush_due_to_jump;
+    wire redirect = flush_due_to_branch || redirect_decode;
 
-    // Stall Logic
-    wire stall_fetch_stage = !instruction_grant;
-    wire stall_global = stall_backend || stall_fetch_stage;
+    // Stall Logic: fetch waits for the I-Cache or for room in the fetch queue.
+    // An instruction transfers when valid and the queue is ready; until then the
+    // PC holds, so the I-Cache keeps presenting the same word.
+    // Backend stalls only stop the queue from draining.
+    wire fetch_queue_ready;
+    wire fetch_queue_second_ready;
+    wire stall_fetch_stage = !instruction_valid;
+    wire stall_global = !fetch_queue_ready || stall_fetch_stage;
+
+    // Dual fetch: the next word of the line enters the queue too, unless the first is
+    // predicted taken or the second could redirect (it gets no prediction of its own)
+    wire [6:0] second_opcode = second_instruction[6:0];
+    wire second_is_control = (second_opcode == 7'b1100011) || (second_opcode == 7'b1101111) ||
+                             (second_opcode == 7'b1100111);
+    wire fetch_second = (DUAL_ISSUE != 0) && second_instruction_valid && !predicted_taken && !second_is_control;
+    wire fetch_pair = fetch_second && fetch_queue_second_ready;
 
     // =========================================================================
     // IF Stage Logic
@@ -68,53 +111,100 @@ module frontend (
         .clk(clk),
         .rst_n(rst_n),
         .program_counter_fetch(program_counter_current),
+        .instruction_fetch(fetch_stage_instruction),
         .prediction_taken(prediction_taken),
         .prediction_target(prediction_target),
+        .prediction_history(prediction_history),
+        .fetch_advance(!stall_global && !flush_due_to_trap),
         .program_counter_execute(id_ex_program_counter),
         .branch_taken_execute(branch_taken_execute || is_jump_execute), 
         .branch_target_execute((is_jump_execute && is_jalr_execute) ? jalr_target_execute : branch_target_execute),
         .is_branch_execute(is_branch_execute),
-        .is_jump_execute(is_jump_execute)
+        .is_jump_execute(is_jump_execute),
+        .history_execute(prediction_history_execute),
+        .mispredict_execute(flush_due_to_branch),
+        .history_decode(if_id_prediction_history),
+        .is_branch_decode(flush_due_to_branch_decode),
+        .branch_taken_decode(branch_taken_decode),
+        .mispredict_decode(redirect_decode),
+        .execute_advance(execute_advance),
+        .restore(flush_due_to_trap)
+    );
+
+    // Return Address Stack
+    return_address_stack u_return_address_stack (
+        .clk(clk),
+        .rst_n(rst_n),
+        .fetch_program_counter(program_counter_current),
+        .fetch_instruction(fetch_stage_instruction),
+        .fetch_advance(!stall_global && !flush_due_to_trap),
+        .predict_return(ras_predict_return),
+        .return_target(ras_return_target),
+        .execute_program_counter(id_ex_program_counter),
+        .is_jump_execute(is_jump_execute),
+        .is_jalr_execute(is_jalr_execute),
+        .rd_index_execute(rd_index_execute),
+        .rs1_index_execute(rs1_index_execute),
+        .execute_advance(execute_advance),
+        .mispredict_execute(flush_due_to_branch),
+        .decode_program_counter(if_id_program_counter),
+        .decode_instruction(if_id_instruction),
+        .restore_decode(redirect_decode),
+        .restore(redirect || flush_due_to_trap)
     );
 
     // PC Next Logic
-    // Priority: Reset > Interrupt/Trap > Mispredict > Stall > Prediction > Next
+    // Priority: Reset > Interrupt/Trap > Mispredict > Stall > Prediction > Pair > Next
     // Note: Mispredict logic is handled in Backend to generate flush signals, 
     // but we need to know WHICH PC to take.
     // Backend provides: correct_pc (for mispredict), trap_pc (for traps)
     always @(*) begin
         if (pc_mux_select_trap) begin
             program_counter_next = trap_pc;
-        end else if (flush_due_to_branch || flush_due_to_jump) begin
+        end else if (redirect) begin
             program_counter_next = correct_pc; // Mispredict recovery
         end else if (stall_global) begin
             program_counter_next = program_counter_current; // Stall: Hold PC
-        end else if (prediction_taken) begin
-            program_counter_next = prediction_target;
+        end else if (predicted_taken) begin
+            program_counter_next = predicted_target;
+        end else if (fetch_pair) begin
+            program_counter_next = program_counter_current + 8; // Both words entered the queue
         end else begin
             program_counter_next = program_counter_current + 4;
         end
     end
 
-    // IF/ID Pipeline Register
-    always @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            if_id_program_counter <= 0;
-            if_id_instruction <= 0; // NOP
-            if_id_prediction_taken <= 0;
-            if_id_prediction_target <= 0;
-        end else if (flush_due_to_branch || flush_due_to_jump || flush_due_to_trap) begin
-            if_id_program_counter <= 0;
-            if_id_instruction <= 0; // Flush -> NOP
-            if_id_prediction_taken <= 0;
-            if_id_prediction_target <= 0;
-        end else if (!stall_global) begin
-            if_id_program_counter <= program_counter_current;
-            if_id_instruction <= fetch_stage_instruction;
-            if_id_prediction_taken <= prediction_taken;
-            if_id_prediction_target <= prediction_target;
-        end
-        // If stall, hold value
-    end
+    // Fetch Queue (IF/ID): filled whenever the I-Cache has a valid instruction,
+    // drained whenever the backend moves its ID instruction on. Empty -> NOP.
+    fetch_queue #(
+        .DEPTH(FETCH_QUEUE_DEPTH)
+    ) u_fetch_queue (
+        .clk(clk),
+        .rst_n(rst_n),
+        .push(!stall_fetch_stage),
+        .push_program_counter(program_counter_current),
+        .push_instruction(fetch_stage_instruction),
+        .push_prediction_taken(predicted_taken),
+        .push_prediction_target(predicted_target),
+        .push_prediction_history(prediction_history),
+        .push_ready(fetch_queue_ready),
+        .push_second(fetch_second),
+        .push_second_program_counter(program_counter_current + 32'd4),
+        .push_second_instruction(second_instruction),
+        .push_second_ready(fetch_queue_second_ready),
+        .pop(!stall_backend),
+        .head_program_counter(if_id_program_counter),
+        .head_instruction(if_id_instruction),
+        .head_prediction_taken(if_id_prediction_taken),
+        .head_prediction_target(if_id_prediction_target),
+        .head_prediction_history(if_id_prediction_history),
+        .empty(),
+        .pop_second(issue_second),
+        .second_program_counter(if_id_second_program_counter),
+        .second_instruction(if_id_second_instruction),
+        .second_prediction_taken(if_id_second_prediction_taken),
+        .second_valid(if_id_second_valid),
+        .flush(redirect || flush_due_to_trap)
+    );
 
 endmodule
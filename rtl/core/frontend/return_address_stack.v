@@ -0,0 +1,159 @@
+module return_address_stack (
+    input wire clk,
+    input wire rst_n,
+
+    // IF Stage: predecode the fetched instruction, predict returns
+    input wire [31:0] fetch_program_counter,
+    input wire [31:0] fetch_instruction,
+    input wire fetch_advance,             // The fetched instruction enters IF/ID this cycle
+    output wire predict_return,
+    output wire [31:0] return_target,
+
+    // EX Stage: resolved calls/returns update the non-speculative copy
+    input wire [31:0] execute_program_counter,
+    input wire is_jump_execute,
+    input wire is_jalr_execute,
+    input wire [4:0] rd_index_execute,
+    input wire [4:0] rs1_index_execute,
+    input wire execute_advance,           // The EX instruction moves on to MEM this cycle
+    input wire mispredict_execute,
+
+    // ID Stage: an ID redirect keeps the decoded instruction, so its own push/pop is replayed
+    input wire [31:0] decode_program_counter,
+    input wire [31:0] decode_instruction,
+    input wire restore_decode,            // The restore comes from an ID redirect
+
+    // Flush: restore the speculative stack from the non-speculative copy
+    input wire restore
+);
+
+    // Circular stack; overflow overwrites the oldest entry
+    parameter DEPTH = 8;
+    parameter PTR_BITS = 3; // log2(DEPTH)
+
+    // Speculative stack (updated at fetch)
+    reg [31:0] stack [0:DEPTH-1];
+    reg [PTR_BITS-1:0] top;
+    reg [PTR_BITS:0] count;
+
+    // Checkpoint: the same stack updated only by instructions that left EX
+    reg [31:0] committed_stack [0:DEPTH-1];
+    reg [PTR_BITS-1:0] committed_top;
+    reg [PTR_BITS:0] committed_count;
+
+    // Return prediction statistics (returns leaving EX, and those whose target was right)
+    reg [31:0] return_count;
+    reg [31:0] return_hits;
+
+    // Link registers are x1 (ra) and x5 (t0). Following the RISC-V JALR hints:
+    // push when rd is a link register, pop when rs1 is a link register, except
+    // rd == rs1 (push only). rd and rs1 both links but different: pop, then push.
+    function is_link;
+        input [4:0] index;
+        begin
+            is_link = (index == 5'd1) || (index == 5'd5);
+        end
+    endfunction
+
+    // -------------------------------------------------------------------------
+    // IF Stage
+    // -------------------------------------------------------------------------
+    wire [6:0] opcode_if = fetch_instruction[6:0];
+    wire [4:0] rd_if = fetch_instruction[11:7];
+    wire [4:0] rs1_if = fetch_instruction[19:15];
+    wire jal_if = (opcode_if == 7'b1101111);
+    wire jalr_if = (opcode_if == 7'b1100111) && (fetch_instruction[14:12] == 3'b000);
+
+    wire push_if = (jal_if || jalr_if) && is_link(rd_if);
+    wire pop_if = jalr_if && is_link(rs1_if) && !(is_link(rd_if) && rd_if == rs1_if);
+
+    wire [31:0] return_offset = {{20{fetch_instruction[31]}}, fetch_instruction[31:20]};
+    assign predict_return = pop_if && (count != 0);
+    assign return_target = (stack[top] + return_offset) & 32'hFFFFFFFE;
+
+    // -------------------------------------------------------------------------
+    // ID Stage
+    // -------------------------------------------------------------------------
+    wire [6:0] opcode_id = decode_instruction[6:0];
+    wire [4:0] rd_id = decode_instruction[11:7];
+    wire [4:0] rs1_id = decode_instruction[19:15];
+    wire jal_id = (opcode_id == 7'b1101111);
+    wire jalr_id = (opcode_id == 7'b1100111) && (decode_instruction[14:12] == 3'b000);
+
+    wire push_id = restore_decode && (jal_id || jalr_id) && is_link(rd_id);
+    wire pop_id = restore_decode && jalr_id && is_link(rs1_id) && !(is_link(rd_id) && rd_id == rs1_id);
+
+    // -------------------------------------------------------------------------
+    // EX Stage
+    // -------------------------------------------------------------------------
+    wire push_ex = is_jump_execute && is_link(rd_index_execute);
+    wire pop_ex = is_jump_execute && is_jalr_execute && is_link(rs1_index_execute) &&
+                  !(is_link(rd_index_execute) && rd_index_execute == rs1_index_execute);
+    wire commit = execute_advance && (push_ex || pop_ex);
+
+    // Non-speculative stack after this cycle's commit (restore source)
+    wire [PTR_BITS-1:0] committed_top_popped = pop_ex ? committed_top - 1 : committed_top;
+    wire [PTR_BITS-1:0] committed_top_next = !commit ? committed_top :
+                                             push_ex ? committed_top_popped + 1 : committed_top_popped;
+    wire [PTR_BITS:0] committed_count_popped = (pop_ex && committed_count != 0) ? committed_count - 1 : committed_count;
+    wire [PTR_BITS:0] committed_count_next = !commit ? committed_count :
+                                             (push_ex && committed_count_popped != DEPTH) ? committed_count_popped + 1 :
+                                             committed_count_popped;
+    wire [31:0] link_address_ex = execute_program_counter + 4;
+
+    // Restored stack with the ID instruction replayed on top
+    wire [PTR_BITS-1:0] restored_top_popped = pop_id ? committed_top_next - 1 : committed_top_next;
+    wire [PTR_BITS:0] restored_count_popped = (pop_id && committed_count_next != 0) ? committed_count_next - 1 : committed_count_next;
+    wire [PTR_BITS-1:0] restored_top = push_id ? restored_top_popped + 1 : restored_top_popped;
+    wire [PTR_BITS:0] restored_count = (push_id && restored_count_popped != DEPTH) ? restored_count_popped + 1 : restored_count_popped;
+
+    integer i;
+    initial begin
+        for (i = 0; i < DEPTH; i = i + 1) begin
+            stack[i] = 0;
+            committed_stack[i] = 0;
+        end
+    end
+
+    integer k;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            top <= 0;
+            count <= 0;
+            committed_top <= 0;
+            committed_count <= 0;
+            return_count <= 0;
+            return_hits <= 0;
+        end else begin
+            if (commit) begin
+                committed_top <= committed_top_next;
+                committed_count <= committed_count_next;
+                if (push_ex) committed_stack[committed_top_next] <= link_address_ex;
+                if (pop_ex) begin
+                    return_count <= return_count + 1;
+                    if (!mispredict_execute) return_hits <= return_hits + 1;
+                end
+            end
+
+            if (restore) begin
+                for (k = 0; k < DEPTH; k = k + 1) begin
+                    stack[k] <= (push_id && k == restored_top) ? decode_program_counter + 4 :
+                                (commit && push_ex && k == committed_top_next) ? link_address_ex : committed_stack[k];
+                end
+                top <= restored_top;
+                count <= restored_count;
+            end else if (fetch_advance && (push_if || pop_if)) begin
+                if (push_if) begin
+                    // Pop-then-push replaces the top entry
+                    top <= pop_if ? top : top + 1;
+                    stack[pop_if ? top : top + 1] <= fetch_program_counter + 4;
+                    if (!pop_if && count != DEPTH) count <= count + 1;
+                end else begin
+                    top <= top - 1;
+                    if (count != 0) count <= count - 1;
+                end
+            end
+        end
+    end
+
+endmodule
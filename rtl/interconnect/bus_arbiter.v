@@ -10,6 +10,8 @@ module bus_arbiter (
     input wire [3:0]  m0_wstrb,
     input wire        m0_write,
     input wire        m0_enable,
+    input wire        m0_burst,
+    input wire        m0_abort,
     output reg [31:0] m0_rdata,
     output reg        m0_ready,
 
@@ -19,6 +21,8 @@ module bus_arbiter (
     input wire [3:0]  m1_wstrb,
     input wire        m1_write,
     input wire        m1_enable,
+    input wire        m1_burst,
+    input wire        m1_abort,
     output reg [31:0] m1_rdata,
     output reg        m1_ready,
 
@@ -28,8 +32,14 @@ module bus_arbiter (
     output reg [3:0]  bus_wstrb,
     output reg        bus_write,
     output reg        bus_enable,
+    output reg        bus_burst,
+    output reg        bus_abort, // The owner ends its burst early (a new request may start in the same cycle)
     input wire [31:0] bus_rdata,
-    input wire        bus_ready
+    input wire        bus_ready,
+
+    // Master driving the downstream bus this cycle
+    output wire       m0_grant,
+    output wire       m1_grant
 );
 
     // State Definition
@@ -40,6 +50,12 @@ module bus_arbiter (
     reg [1:0] current_owner;
     reg       priority_m1; // 0: M0 has priority, 1: M1 has priority
 
+    // Burst Lock: the owner keeps the bus until the last of the 4 beats. An abort restarts
+    // the count: the beat in that cycle, if any, belongs to the owner's new request.
+    reg [1:0] burst_beat;
+    wire [1:0] current_beat = bus_abort ? 2'd0 : burst_beat;
+    wire      transfer_done = bus_ready && (!bus_burst || current_beat == 2'd3);
+
     // Combinational Winner Logic
     wire [1:0] winner_comb;
     assign winner_comb = (m0_enable && m1_enable) ? (priority_m1 ? OWNER_M1 : OWNER_M0) :
@@ -55,7 +71,7 @@ module bus_arbiter (
         case (current_owner)
             OWNER_NONE: begin
                 // If the winner finishes immediately (ready=1), we need to decide next_owner for NEXT cycle.
-                if (bus_ready && winner_comb != OWNER_NONE) begin
+                if (transfer_done && winner_comb != OWNER_NONE) begin
                     // If winner was M0, next preference is M1.
                     if (winner_comb == OWNER_M0) begin
                         if (m1_enable) next_owner = OWNER_M1;
@@ -79,8 +95,8 @@ module bus_arbiter (
                     if (m1_enable) next_owner = OWNER_M1;
                     else next_owner = OWNER_NONE;
                 end
-                // If transaction finishes (ready=1), we can switch
-                else if (bus_ready) begin
+                // If transaction finishes (last ready), we can switch
+                else if (transfer_done) begin
                     // Check if M1 wants it (Round Robin)
                     if (m1_enable) begin
                         next_owner = OWNER_M1;
@@ -99,7 +115,7 @@ module bus_arbiter (
                     if (m0_enable) next_owner = OWNER_M0;
                     else next_owner = OWNER_NONE;
                 end
-                else if (bus_ready) begin
+                else if (transfer_done) begin
                     // Check if M0 wants it
                     if (m0_enable) begin
                         next_owner = OWNER_M0;
@@ -118,10 +134,19 @@ module bus_arbiter (
         if (!rst_n) begin
             current_owner <= OWNER_NONE;
             priority_m1 <= 0;
+            burst_beat <= 0;
         end else begin
             current_owner <= next_owner;
+
+            if (bus_enable && bus_burst) begin
+                if (bus_ready) burst_beat <= current_beat + 1;
+                else if (bus_abort) burst_beat <= 0;
+            end else begin
+                burst_beat <= 0;
+            end
+
             // Update priority only when switching owners or completing a transaction
-            if (bus_ready && bus_enable) begin
+            if (transfer_done && bus_enable) begin
                 if (effective_owner == OWNER_M0) priority_m1 <= 1;
                 if (effective_owner == OWNER_M1) priority_m1 <= 0;
             end
@@ -133,6 +158,9 @@ module bus_arbiter (
     // Use combinational logic for low latency (0-cycle arbitration)
     wire [1:0] effective_owner = (current_owner != OWNER_NONE) ? current_owner : winner_comb;
 
+    assign m0_grant = (effective_owner == OWNER_M0);
+    assign m1_grant = (effective_owner == OWNER_M1);
+
     always @(*) begin
         // Defaults
         bus_addr = 0;
@@ -140,6 +168,8 @@ module bus_arbiter (
         bus_wstrb = 0;
         bus_write = 0;
         bus_enable = 0;
+        bus_burst = 0;
+        bus_abort = 0;
         
         m0_rdata = 0;
         m0_ready = 0;
@@ -153,6 +183,8 @@ module bus_arbiter (
                 bus_wstrb  = m0_wstrb;
                 bus_write  = m0_write;
                 bus_enable = m0_enable;
+                bus_burst  = m0_burst;
+                bus_abort  = m0_abort;
                 
                 m0_rdata   = bus_rdata;
                 m0_ready   = bus_ready;
@@ -163,6 +195,8 @@ module bus_arbiter (
                 bus_wstrb  = m1_wstrb;
                 bus_write  = m1_write;
                 bus_enable = m1_enable;
+                bus_burst  = m1_burst;
+                bus_abort  = m1_abort;
                 
                 m1_rdata   = bus_rdata;
                 m1_ready   = bus_ready;
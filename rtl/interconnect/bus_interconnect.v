@@ -8,6 +8,8 @@ module bus_interconnect (
     input wire [3:0]  m0_wstrb,
     input wire        m0_write,
     input wire        m0_enable,
+    input wire        m0_burst,
+    input wire        m0_abort,
     output wire [31:0] m0_rdata,
     output wire       m0_ready,
 
@@ -17,6 +19,8 @@ module bus_interconnect (
     input wire [3:0]  m1_wstrb,
     input wire        m1_write,
     input wire        m1_enable,
+    input wire        m1_burst,
+    input wire        m1_abort,
     output wire [31:0] m1_rdata,
     output wire       m1_ready,
 
@@ -27,6 +31,8 @@ module bus_interconnect (
     output wire [3:0]  s0_wstrb,
     output wire        s0_write,
     output wire        s0_enable,
+    output wire        s0_burst, // Only the RAM slave supports line bursts
+    output wire        s0_abort, // The master ends its burst early
     input wire [31:0]  s0_rdata,
     input wire         s0_ready,
 
@@ -48,7 +54,11 @@ module bus_interconnect (
     output wire        s2_write,
     output wire        s2_enable,
     input wire [31:0]  s2_rdata,
-    input wire         s2_ready
+    input wire         s2_ready,
+
+    // Master whose request the slaves see this cycle
+    output wire        m0_grant,
+    output wire        m1_grant
 );
 
     // Internal Bus Signals (Output of Arbiter)
@@ -57,6 +67,8 @@ module bus_interconnect (
     wire [3:0]  bus_wstrb;
     wire        bus_write;
     wire        bus_enable;
+    wire        bus_burst;
+    wire        bus_abort;
     reg [31:0]  bus_rdata;
     reg         bus_ready;
 
@@ -70,6 +82,8 @@ module bus_interconnect (
         .m0_wstrb(m0_wstrb),
         .m0_write(m0_write),
         .m0_enable(m0_enable),
+        .m0_burst(m0_burst),
+        .m0_abort(m0_abort),
         .m0_rdata(m0_rdata),
         .m0_ready(m0_ready),
         // Master 1
@@ -78,6 +92,8 @@ module bus_interconnect (
         .m1_wstrb(m1_wstrb),
         .m1_write(m1_write),
         .m1_enable(m1_enable),
+        .m1_burst(m1_burst),
+        .m1_abort(m1_abort),
         .m1_rdata(m1_rdata),
         .m1_ready(m1_ready),
         // Downstream
@@ -86,8 +102,12 @@ module bus_interconnect (
         .bus_wstrb(bus_wstrb),
         .bus_write(bus_write),
         .bus_enable(bus_enable),
+        .bus_burst(bus_burst),
+        .bus_abort(bus_abort),
         .bus_rdata(bus_rdata),
-        .bus_ready(bus_ready)
+        .bus_ready(bus_ready),
+        .m0_grant(m0_grant),
+        .m1_grant(m1_grant)
     );
 
     // Address Decoding
@@ -115,6 +135,8 @@ module bus_interconnect (
     assign s0_wdata = bus_wdata;
     assign s0_wstrb = bus_wstrb;
     assign s0_write = bus_write;
+    assign s0_burst = bus_burst;
+    assign s0_abort = bus_abort;
     
     assign s1_addr = bus_addr;
     assign s1_wdata = bus_wdata;
@@ -15,8 +15,8 @@ module main_memory (
     output reg [31:0] read_data_b
 );
 
-    // 64KB Memory (16384 words)
-    reg [31:0] memory [0:16383];
+    // 64KB Memory (16384 words); testbenches load programs into it directly
+    reg [31:0] memory [0:16383] /*verilator public_flat_rw*/;
 
     // Port A: Read Only (Instruction) - Asynchronous Read
     always @(*) begin
@@ -26,7 +26,9 @@ module main_memory (
     // Port B: Read/Write (Data)
     always @(posedge clk) begin
         if (write_enable_b) begin
+`ifdef DEBUG_LOG // Per-access trace (verilate with +define+DEBUG_LOG)
             $display("MAIN_MEMORY: Write addr=%h data=%h be=%b", address_b, write_data_b, byte_enable_b);
+`endif
             if (byte_enable_b[0]) memory[address_b[15:2]][7:0]   <= write_data_b[7:0];
             if (byte_enable_b[1]) memory[address_b[15:2]][15:8]  <= write_data_b[15:8];
             if (byte_enable_b[2]) memory[address_b[15:2]][23:16] <= write_data_b[23:16];
@@ -37,9 +39,11 @@ module main_memory (
     // Port B Read - Asynchronous Read
     always @(*) begin
         read_data_b = memory[address_b[15:2]];
+`ifdef DEBUG_LOG
         if (address_b == 32'h1000) begin
              $display("MAIN_MEMORY: Read addr=%h data=%h", address_b, read_data_b);
         end
+`endif
     end
 
 endmodule
@@ -14,8 +14,8 @@ module timer (
     // 0x40004008: mtimecmp (Low)
     // 0x4000400C: mtimecmp (High)
 
-    reg [63:0] mtime;
-    reg [63:0] mtimecmp;
+    reg [63:0] mtime /*verilator public_flat_rw*/; // Idle fast-forward writes it
+    reg [63:0] mtimecmp /*verilator public_flat_rd*/;
 
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
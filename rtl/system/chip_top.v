@@ -5,9 +5,16 @@ module chip_top (
     input wire rst_n,
     output wire [31:0] pc_out,
     output wire [31:0] instr_out,
-    output wire [31:0] alu_res_out
+    output wire [31:0] alu_res_out,
+    output wire wfi_idle // Every core is parked on WFI: only the timer can wake them (idle fast-forward)
 );
 
+    parameter MUL_LATENCY = 1; // MDU multiplier pipeline depth in every tile (0 = combinational)
+    parameter BRANCH_RESOLVE_DECODE = 1; // Early (ID stage) branch and JAL resolution in every tile (0 = off)
+    parameter FETCH_QUEUE_DEPTH = 4; // Fetch queue entries in every tile (1 = a plain IF/ID register)
+    parameter DUAL_ISSUE = 0; // Dual-issue mode in every tile (second, ALU-only pipe)
+    parameter THREADS = 1; // Hardware contexts per tile (1 to 4); tile n runs harts n*THREADS and up
+
     // Bus Signals
     // Master 0 (Tile 0)
     wire [31:0] m0_addr;
@@ -15,6 +22,8 @@ module chip_top (
     wire [3:0]  m0_be;
     wire        m0_we;
     wire        m0_req;
+    wire        m0_burst;
+    wire        m0_abort;
     wire [31:0] m0_rdata;
     wire        m0_ready;
 
@@ -24,6 +33,8 @@ module chip_top (
     wire [3:0]  m1_be;
     wire        m1_we;
     wire        m1_req;
+    wire        m1_burst;
+    wire        m1_abort;
     wire [31:0] m1_rdata;
     wire        m1_ready;
 
@@ -33,6 +44,8 @@ module chip_top (
     wire [3:0]  s0_be;
     wire        s0_we;
     wire        s0_en;
+    wire        s0_burst;
+    wire        s0_abort;
     wire [31:0] s0_rdata;
     wire        s0_ready;
 
@@ -56,9 +69,25 @@ module chip_top (
 
     // Interrupts
     wire timer_irq;
+    wire wait_for_interrupt_tile_0;
+    wire wait_for_interrupt_tile_1;
+    assign wfi_idle = wait_for_interrupt_tile_0 && wait_for_interrupt_tile_1;
+
+    // L2 misses, charged to the tile the bus arbiter granted (performance counters)
+    wire l2_miss;
+    wire bus_grant_tile_0;
+    wire bus_grant_tile_1;
+    wire l2_miss_tile_0 = l2_miss && bus_grant_tile_0;
+    wire l2_miss_tile_1 = l2_miss && bus_grant_tile_1;
 
-    // Core Tile 0 (Hart 0)
-    core_tile u_tile_0 (
+    // Core Tile 0 (Hart 0, or harts 0..THREADS-1)
+    core_tile #(
+        .MUL_LATENCY(MUL_LATENCY),
+        .BRANCH_RESOLVE_DECODE(BRANCH_RESOLVE_DECODE),
+        .FETCH_QUEUE_DEPTH(FETCH_QUEUE_DEPTH),
+        .DUAL_ISSUE(DUAL_ISSUE),
+        .THREADS(THREADS)
+    ) u_tile_0 (
         .clk(clk),
         .rst_n(rst_n),
         .hart_id(32'd0),
@@ -67,24 +96,38 @@ module chip_top (
         .bus_be(m0_be),
         .bus_we(m0_we),
         .bus_req(m0_req),
+        .bus_burst(m0_burst),
+        .bus_abort(m0_abort),
         .bus_rdata(m0_rdata),
         .bus_ready(m0_ready),
-        .timer_irq(timer_irq)
+        .timer_irq(timer_irq),
+        .wait_for_interrupt(wait_for_interrupt_tile_0),
+        .l2_miss(l2_miss_tile_0)
     );
 
-    // Core Tile 1 (Hart 1)
-    core_tile u_tile_1 (
+    // Core Tile 1 (Hart 1, or harts THREADS..2*THREADS-1)
+    core_tile #(
+        .MUL_LATENCY(MUL_LATENCY),
+        .BRANCH_RESOLVE_DECODE(BRANCH_RESOLVE_DECODE),
+        .FETCH_QUEUE_DEPTH(FETCH_QUEUE_DEPTH),
+        .DUAL_ISSUE(DUAL_ISSUE),
+        .THREADS(THREADS)
+    ) u_tile_1 (
         .clk(clk),
         .rst_n(rst_n),
-        .hart_id(32'd1),
+        .hart_id(THREADS),
         .bus_addr(m1_addr),
         .bus_wdata(m1_wdata),
         .bus_be(m1_be),
         .bus_we(m1_we),
         .bus_req(m1_req),
+        .bus_burst(m1_burst),
+        .bus_abort(m1_abort),
         .bus_rdata(m1_rdata),
         .bus_ready(m1_ready),
-        .timer_irq(timer_irq)
+        .timer_irq(timer_irq),
+        .wait_for_interrupt(wait_for_interrupt_tile_1),
+        .l2_miss(l2_miss_tile_1)
     );
 
     // Bus Interconnect
@@ -98,6 +141,8 @@ module chip_top (
         .m0_wstrb(m0_be),
         .m0_write(m0_we),
         .m0_enable(m0_req),
+        .m0_burst(m0_burst),
+        .m0_abort(m0_abort),
         .m0_rdata(m0_rdata),
         .m0_ready(m0_ready),
 
@@ -107,6 +152,8 @@ module chip_top (
         .m1_wstrb(m1_be),
         .m1_write(m1_we),
         .m1_enable(m1_req),
+        .m1_burst(m1_burst),
+        .m1_abort(m1_abort),
         .m1_rdata(m1_rdata),
         .m1_ready(m1_ready),
 
@@ -116,6 +163,8 @@ module chip_top (
         .s0_wstrb(s0_be),
         .s0_write(s0_we),
         .s0_enable(s0_en),
+        .s0_burst(s0_burst),
+        .s0_abort(s0_abort),
         .s0_rdata(s0_rdata),
         .s0_ready(s0_ready),
 
@@ -135,7 +184,10 @@ module chip_top (
         .s2_write(s2_we),
         .s2_enable(s2_en),
         .s2_rdata(s2_rdata),
-        .s2_ready(s2_ready)
+        .s2_ready(s2_ready),
+
+        .m0_grant(bus_grant_tile_0),
+        .m1_grant(bus_grant_tile_1)
     );
 
     // L2 Cache <-> Memory Signals
@@ -144,6 +196,7 @@ module chip_top (
     wire [3:0]  l2_mem_be;
     wire        l2_mem_we;
     wire        l2_mem_req;
+    wire        l2_mem_burst;
     wire [31:0] l2_mem_rdata;
     wire        l2_mem_ready;
 
@@ -157,6 +210,8 @@ module chip_top (
         .s_be(s0_be),
         .s_we(s0_we),
         .s_en(s0_en),
+        .s_burst(s0_burst),
+        .s_abort(s0_abort),
         .s_rdata(s0_rdata),
         .s_ready(s0_ready),
         // Memory Interface
@@ -165,8 +220,10 @@ module chip_top (
         .mem_be(l2_mem_be),
         .mem_we(l2_mem_we),
         .mem_req(l2_mem_req),
+        .mem_burst(l2_mem_burst),
         .mem_rdata(l2_mem_rdata),
-        .mem_ready(l2_mem_ready)
+        .mem_ready(l2_mem_ready),
+        .demand_miss(l2_miss)
     );
 
     // Memory Subsystem (Main Memory)
@@ -186,6 +243,7 @@ module chip_top (
         .dcache_mem_be(l2_mem_be),
         .dcache_mem_we(l2_mem_we),
         .dcache_mem_req(l2_mem_req),
+        .dcache_mem_burst(l2_mem_burst),
         .dcache_mem_rdata(l2_mem_rdata),
         .dcache_mem_ready(l2_mem_ready)
     );
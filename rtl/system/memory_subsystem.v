@@ -16,10 +16,16 @@ module memory_subsystem (
     input wire [3:0]  dcache_mem_be,
     input wire        dcache_mem_we,
     input wire        dcache_mem_req,
+    input wire        dcache_mem_burst, // 4-beat wrapping read burst from dcache_mem_addr
     output wire [31:0] dcache_mem_rdata,
     output wire       dcache_mem_ready
 );
 
+    // Port B burst: the address is held for the whole burst, beats wrap within the line
+    reg [1:0] dmem_beat;
+    wire [1:0] dmem_beat_word = dcache_mem_addr[3:2] + dmem_beat;
+    wire [31:0] dmem_addr = dcache_mem_burst ? {dcache_mem_addr[31:4], dmem_beat_word, 2'b00} : dcache_mem_addr;
+
     // Instantiate Main Memory (Unified)
     main_memory u_main_memory (
         .clk(clk),
@@ -27,7 +33,7 @@ module memory_subsystem (
         .address_a(icache_mem_addr),
         .read_data_a(icache_mem_rdata),
         // Port B: Data
-        .address_b(dcache_mem_addr),
+        .address_b(dmem_addr),
         .write_data_b(dcache_mem_wdata),
         .write_enable_b(dcache_mem_we),
         .byte_enable_b(dcache_mem_be),
@@ -61,6 +67,7 @@ module memory_subsystem (
     assign icache_mem_ready = imem_ready_reg;
 
     // Data Memory Latency Logic (Port B)
+    // A burst pays the access latency once, then streams one beat per cycle
     reg [2:0] dmem_wait_counter;
     reg dmem_ready_reg;
 
@@ -68,8 +75,13 @@ module memory_subsystem (
         if (!rst_n) begin
             dmem_wait_counter <= 0;
             dmem_ready_reg <= 0;
+            dmem_beat <= 0;
         end else if (dcache_mem_req) begin
-            if (dmem_wait_counter < 2) begin // 2 cycle latency
+            if (dcache_mem_burst && dmem_ready_reg) begin
+                // Beat delivered this cycle
+                dmem_beat <= dmem_beat + 1;
+                dmem_ready_reg <= (dmem_beat != 2'd3);
+            end else if (dmem_wait_counter < 2) begin // 2 cycle latency
                 dmem_wait_counter <= dmem_wait_counter + 1;
                 dmem_ready_reg <= 0;
             end else begin
@@ -80,6 +92,7 @@ module memory_subsystem (
         end else begin
             dmem_wait_counter <= 0;
             dmem_ready_reg <= 0;
+            dmem_beat <= 0;
         end
     end
     assign dcache_mem_ready = dmem_ready_reg;
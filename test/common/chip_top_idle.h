@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Vchip_top.h>
+#include <Vchip_top___024root.h>
+#include <cstdint>
+
+namespace chip_top_util {
+    // Idle fast-forward: while every core is parked on WFI (wfi_idle) only the timer can
+    // wake them, so jump mtime to mtimecmp instead of ticking through the wait.
+    // Call between ticks. Returns the cycles skipped (0 if a core runs or no event is armed).
+    // mcycle is not advanced by the skipped cycles.
+    inline uint64_t fast_forward_timer(Vchip_top* dut) {
+        if (!dut->wfi_idle) return 0;
+        uint64_t mtime = dut->rootp->chip_top__DOT__u_timer__DOT__mtime;
+        uint64_t mtimecmp = dut->rootp->chip_top__DOT__u_timer__DOT__mtimecmp;
+        if (mtimecmp <= mtime || mtimecmp == UINT64_MAX) return 0;
+        dut->rootp->chip_top__DOT__u_timer__DOT__mtime = mtimecmp;
+        return mtimecmp - mtime;
+    }
+}
@@ -1,59 +1,91 @@
 #pragma once
 
+// TB_TRACE=0: the model was verilated without --trace (fast flavour), so there is no VCD output
+#ifndef TB_TRACE
+#define TB_TRACE 1
+#endif
+
 #include <verilated.h>
+#if TB_TRACE
 #include <verilated_vcd_c.h>
+#endif
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
 #include <iostream>
 #include <iomanip>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 /**
  * Base class for all Verilator testbenches
  * Provides common utilities for clock, reset, tracing, etc.
+ * Each instance owns its VerilatedContext (time, trace state, plusargs), so several
+ * testbenches can simulate independently in one process, one per host thread.
  */
 template<typename DUT>
 class TestbenchBase {
 protected:
+    std::unique_ptr<VerilatedContext> context;
     std::unique_ptr<DUT> dut;
+#if TB_TRACE
     std::unique_ptr<VerilatedVcdC> trace;
-    uint64_t sim_time;
+#endif
     bool trace_enabled;
     
 public:
     TestbenchBase(bool enable_trace = true, const std::string& trace_filename = "trace.vcd")
-        : sim_time(0), trace_enabled(enable_trace) {
+        : trace_enabled(enable_trace) {
         
-        dut = std::make_unique<DUT>();
+        context = std::make_unique<VerilatedContext>();
+#if TB_TRACE
+        context->traceEverOn(trace_enabled);
+#endif
+        dut = std::make_unique<DUT>(context.get(), "TOP");
         
+#if TB_TRACE
         if (trace_enabled) {
-            Verilated::traceEverOn(true);
             trace = std::make_unique<VerilatedVcdC>();
             dut->trace(trace.get(), 99);  // Trace 99 levels deep
             trace->open(trace_filename.c_str());
             std::cout << "Trace file: " << trace_filename << std::endl;
         }
+#else
+        (void)trace_filename;
+        trace_enabled = false;
+#endif
     }
     
     virtual ~TestbenchBase() {
+#if TB_TRACE
         if (trace) {
             trace->close();
         }
+#endif
         dut->final();
     }
     
     // Evaluate the DUT
     void eval() {
         dut->eval();
+#if TB_TRACE
         if (trace) {
-            trace->dump(sim_time);
+            trace->dump(context->time());
         }
-        sim_time++;
+#endif
+        context->timeInc(1);
     }
     
     // Get current simulation time
     uint64_t get_sim_time() const {
-        return sim_time;
+        return context->time();
     }
     
     // Get DUT instance
@@ -61,11 +93,42 @@ public:
         return dut.get();
     }
     
+    // Get this testbench's Verilator context
+    VerilatedContext* get_context() {
+        return context.get();
+    }
+    
+    // Pass a +plusarg (e.g. "+verilator+prof+vlt+file+profile.vlt") to this model only
+    void add_plusarg(const std::string& arg) {
+        const char* argv[] = {arg.c_str()};
+        context->commandArgsAdd(1, argv);
+    }
+    
+    // Pin the calling thread to host CPUs first_cpu .. first_cpu + count - 1. Call it before
+    // constructing the testbench: the worker threads of a multi-threaded model (--threads)
+    // are created with the DUT and inherit the mask. Linux only; false if not applied.
+    static bool set_thread_affinity(int first_cpu, int count) {
+#ifdef __linux__
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu = first_cpu; cpu < first_cpu + count; cpu++) {
+            CPU_SET(cpu, &cpus);
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+        (void)first_cpu;
+        (void)count;
+        return false;
+#endif
+    }
+    
     // Flush trace (useful for debugging crashes)
     void flush_trace() {
+#if TB_TRACE
         if (trace) {
             trace->flush();
         }
+#endif
     }
 };
 
@@ -126,4 +189,27 @@ namespace tb_util {
         std::cout << name << " = 0x" << std::hex << std::setw(8) 
                   << std::setfill('0') << value << std::dec << std::endl;
     }
+
+    // Run job(0) .. job(count - 1) on a pool of host threads (workers = 0: one per host core).
+    // Each job builds its own testbench, and every testbench has its own VerilatedContext,
+    // so the models simulate independently. Keep doctest assertions out of the jobs: collect
+    // the results and check them after run_parallel() returns.
+    inline void run_parallel(size_t count, const std::function<void(size_t)>& job, unsigned workers = 0) {
+        if (workers == 0) {
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> pool;
+        for (size_t w = 0; w < std::min<size_t>(workers, count); w++) {
+            pool.emplace_back([&] {
+                for (size_t i = next++; i < count; i = next++) {
+                    job(i);
+                }
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
 }
@@ -47,8 +47,8 @@ public:
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__stall_pipeline;
     }
 
-    uint32_t get_grant() {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__instruction_grant_reg;
+    uint32_t get_instruction_valid() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__instruction_valid;
     }
 
     uint32_t get_if_id_pc() {
@@ -3,7 +3,7 @@
 #include "tb_base.h"
 // Test: Backend Module Stall Handling
 // Tests two scenarios:
-// 1. Instruction fetch stall (instruction_grant=0): ID/EX gets bubble, other stages proceed
+// 1. Instruction fetch stall (fetch queue empty, instruction 0): ID/EX gets bubble, other stages proceed
 // 2. Data bus stall (bus_busy=1): Entire pipeline freezes
 
 #include <Vbackend.h>
@@ -28,10 +28,10 @@ public:
         dut->if_id_instruction = 0x00000013; // NOP
         dut->if_id_prediction_taken = 0;
         dut->if_id_prediction_target = 0;
-        dut->instruction_grant = 1;
         dut->bus_read_data = 0;
         dut->bus_busy = 0;
         dut->timer_interrupt_request = 0;
+        dut->cache_miss_events = 0;
         dut->hart_id = 0;
     }
 
@@ -39,15 +39,13 @@ public:
         // Test 1: Feed Instruction 1 (ADDI x1, x0, 10)
         dut->if_id_instruction = 0x00a00093;
         dut->if_id_program_counter = 4;
-        dut->instruction_grant = 1;
         
         tick();
         // End of Cycle 1: ADDI x1 is latched into ID/EX
         
-        // Test 2: Stall Fetch (instruction_grant = 0)
-        dut->instruction_grant = 0;
-        dut->if_id_instruction = 0x01400113; // ADDI x2 (waiting)
-        dut->if_id_program_counter = 8;
+        // Test 2: Stall Fetch (the empty fetch queue presents a bubble)
+        dut->if_id_instruction = 0;
+        dut->if_id_program_counter = 0;
         
         tick();
         eval();
@@ -65,8 +63,9 @@ public:
         CHECK(dut->rootp->backend__DOT__mem_wb_register_write_enable == 1);
         CHECK(dut->rootp->backend__DOT__mem_wb_rd_index == 1);
         
-        // Release Stall
-        dut->instruction_grant = 1;
+        // Release Stall: ADDI x2 arrives
+        dut->if_id_instruction = 0x01400113;
+        dut->if_id_program_counter = 8;
         tick();
         eval();
         // End of Cycle 4: ADDI x2 should now be latched into ID/EX
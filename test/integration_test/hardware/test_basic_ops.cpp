@@ -60,8 +60,8 @@ public:
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__icache_stall;
     }
 
-    bool get_instruction_grant() {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__instruction_grant_reg;
+    bool get_instruction_valid() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__instruction_valid;
     }
     
     uint32_t get_pc_id() {
@@ -128,6 +128,8 @@ ChipTopTestbench tb;
     // Run until EBREAK (PC = 0x18 = 24)
     int cycles = 0;
     bool ebreak_reached = false;
+    bool fetched = false; // Last cycle the I-Cache presented a valid word and IF accepted it
+    uint32_t fetched_pc = 0;
     for (cycles = 0; cycles < 5000; cycles++) {  // Increased from 500
         tb.tick();
         
@@ -137,23 +139,31 @@ ChipTopTestbench tb;
         uint32_t inst_id = tb.get_instruction_id();
         uint8_t icache_state = tb.get_icache_state();
         bool icache_stall = tb.get_icache_stall();
-        bool inst_grant = tb.get_instruction_grant();
+        bool inst_valid = tb.get_instruction_valid();
         bool stall_back = tb.get_stall_backend();
         bool flush_br = tb.get_flush_branch();
         bool flush_jp = tb.get_flush_jump();
         bool flush_tr = tb.get_flush_trap();
         uint32_t icache_inst = tb.get_icache_instruction();
         bool stall_glob = tb.get_stall_global();
+
+        // Same-cycle handshake: an accepted word moves the PC on at the next edge
+        if (fetched) {
+            INFO("Cycle " << cycles);
+            CHECK(pc_if != fetched_pc);
+        }
+        fetched = inst_valid && !stall_glob;
+        fetched_pc = pc_if;
         
         if (cycles < 30 || cycles % 100 == 0) {  // More debug output
-            printf("[DEBUG] Cycle %d: PC_IF=0x%x PC_ID=0x%x(0x%x) PC_EX=0x%x grant=%d stall_g=%d icache_inst=0x%x\n", 
-                   cycles, pc_if, pc_id, inst_id, pc_ex, inst_grant, stall_glob, icache_inst);
+            printf("[DEBUG] Cycle %d: PC_IF=0x%x PC_ID=0x%x(0x%x) PC_EX=0x%x valid=%d stall_g=%d icache_inst=0x%x\n", 
+                   cycles, pc_if, pc_id, inst_id, pc_ex, inst_valid, stall_glob, icache_inst);
         }
         if (pc_ex == 24) { // EBREAK instruction address
             printf("[TB] EBREAK Executed at cycle %d\n", cycles);
             ebreak_reached = true;
-            // Wait for pipeline to flush
-            for (int i = 0; i < 10; i++) {
+            // Wait for pipeline to flush and the posted store to drain to memory
+            for (int i = 0; i < 50; i++) {
                 tb.tick();
             }
             break;
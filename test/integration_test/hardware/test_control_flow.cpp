@@ -11,6 +11,13 @@
 // - JAL x5, 8        (Jump to PC+8, x5 = return address)
 // - ADDI x6, x0, 1   (Skipped)
 // - EBREAK           (Stop)
+//
+// Cold code: a JAL that misses in the BTB redirects from ID, and a loop
+// branch seen for the first time is predicted taken (backward).
+
+#ifndef BRANCH_RESOLVE_DECODE
+#define BRANCH_RESOLVE_DECODE 1
+#endif
 
 #include <Vchip_top.h>
 #include <Vchip_top___024root.h>
@@ -40,6 +47,15 @@ public:
     uint32_t get_pc_ex() {
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
     }
+
+    uint32_t jump_redirects_decode() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__jump_redirect_decode_count;
+    }
+
+    uint32_t branch_redirects_execute() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__branch_redirect_execute_count;
+    }
+
     void do_reset() {
         dut->rst_n = 0;
         for (int i = 0; i < 20; i++) tick();
@@ -91,3 +107,53 @@ ChipTopTestbench tb;
     CHECK(tb.read_register(5) == 0x18);
     CHECK(tb.read_register(6) == 0);
 }
+
+TEST_CASE("Control Flow Cold Code") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0x00300093, // 0x00 ADDI x1, x0, 3
+        0x00000113, // 0x04 ADDI x2, x0, 0
+        0x00c0006f, // 0x08 JAL x0, 12       (BTB miss: redirects from ID)
+        0x00100193, // 0x0c ADDI x3, x0, 1   (Skipped)
+        0x00200193, // 0x10 ADDI x3, x0, 2   (Skipped)
+        0x00110113, // 0x14 ADDI x2, x2, 1   (loop)
+        0xfff08093, // 0x18 ADDI x1, x1, -1
+        0xfe009ce3, // 0x1c BNE x1, x0, -8   (backward: statically predicted taken)
+        0x00100073, // 0x20 EBREAK
+        0x00000013, // NOP
+        0x00000013, // NOP
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until EBREAK (PC = 0x20 = 32)
+    bool ebreak_reached = false;
+    int cycles = 0;
+    for (; cycles < 1000; cycles++) {
+        tb.tick();
+        if (tb.get_pc_ex() == 32) {
+            ebreak_reached = true;
+            for (int i = 0; i < 10; i++) tb.tick();
+            break;
+        }
+    }
+
+    printf("[TB] EBREAK after %d cycles, redirects: %u JAL from ID, %u from EX\n",
+           cycles, tb.jump_redirects_decode(), tb.branch_redirects_execute());
+
+    CHECK(ebreak_reached == true);
+    CHECK(tb.read_register(1) == 0);
+    CHECK(tb.read_register(2) == 3);
+    CHECK(tb.read_register(3) == 0);
+
+    // The first loop iteration is predicted right; only the exit may redirect from EX
+#if BRANCH_RESOLVE_DECODE
+    CHECK(tb.jump_redirects_decode() == 1);
+    CHECK(tb.branch_redirects_execute() <= 1);
+#else
+    CHECK(tb.jump_redirects_decode() == 0);
+    CHECK(tb.branch_redirects_execute() <= 2);
+#endif
+}
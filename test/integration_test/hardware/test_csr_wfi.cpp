@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "tb_base.h"
+// Test: WFI with Idle Fast-Forward
+// Both harts run the program, arm the timer far in the future and park on WFI:
+// - Setup mtvec, enable interrupts (MIE bit in mstatus, MTIE bit in mie)
+// - mtimecmp = 0xF4000 (999424 cycles)
+// - WFI, then ADDI x11, x11, 1 and EBREAK
+// - Handler disarms the timer, sets x10=1, reads mepc into x12 and returns
+// The testbench jumps mtime to mtimecmp once both harts wait, instead of ticking ~1M cycles.
+
+#include <Vchip_top.h>
+#include <Vchip_top___024root.h>
+#include "chip_top_idle.h"
+
+class ChipTopTestbench : public ClockedTestbench<Vchip_top> {
+public:
+    ChipTopTestbench() : ClockedTestbench<Vchip_top>(100, true, "dump.vcd") {
+        dut->rst_n = 0;
+    }
+
+public:
+    void set_clk(uint8_t value) override {
+        dut->clk = value;
+    }
+
+    void load_program(const std::vector<uint32_t>& program) {
+        for (size_t i = 0; i < program.size(); i++) {
+            dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[i] = program[i];
+        }
+    }
+
+    uint32_t read_register(int tile, int reg_idx) {
+        if (reg_idx < 0 || reg_idx >= 32) return 0;
+        if (tile == 0) {
+            return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_regfile__DOT__registers[reg_idx];
+        }
+        return dut->rootp->chip_top__DOT__u_tile_1__DOT__u_core__DOT__u_backend__DOT__u_regfile__DOT__registers[reg_idx];
+    }
+
+    uint64_t get_mtime() {
+        return dut->rootp->chip_top__DOT__u_timer__DOT__mtime;
+    }
+
+    void do_reset() {
+        dut->rst_n = 0;
+        for (int i = 0; i < 20; i++) tick();
+        dut->rst_n = 1;
+        for (int i = 0; i < 5; i++) tick();
+    }
+};
+
+TEST_CASE("Csr WFI") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0x04000093, // 0x00: ADDI x1, x0, 0x40
+        0x30509073, // 0x04: CSRRW x0, mtvec, x1
+        0x00800093, // 0x08: ADDI x1, x0, 0x8
+        0x3000a073, // 0x0C: CSRRS x0, mstatus, x1
+        0x08000093, // 0x10: ADDI x1, x0, 0x80
+        0x3040a073, // 0x14: CSRRS x0, mie, x1
+        0x400040b7, // 0x18: LUI x1, 0x40004
+        0x000f4137, // 0x1C: LUI x2, 0xF4
+        0x0000a623, // 0x20: SW x0, 12(x1) (mtimecmp high = 0)
+        0x0020a423, // 0x24: SW x2, 8(x1) (mtimecmp low = 0xF4000)
+        0x10500073, // 0x28: WFI
+        0x00158593, // 0x2C: ADDI x11, x11, 1
+        0x00100073, // 0x30: EBREAK
+        0x0000006f, // 0x34: J 0x34
+        0x00000013, // 0x38: NOP
+        0x00000013, // 0x3C: NOP (Padding)
+        0x400040b7, // 0x40: LUI x1, 0x40004
+        0xfff00113, // 0x44: ADDI x2, x0, -1
+        0x0020a623, // 0x48: SW x2, 12(x1) (mtimecmp high = all ones: disarm)
+        0x00150513, // 0x4C: ADDI x10, x10, 1
+        0x34102673, // 0x50: CSRRS x12, mepc, x0
+        0x30200073, // 0x54: MRET
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until both harts passed the WFI, fast-forwarding while they wait
+    uint64_t skipped = 0;
+    int cycles = 0;
+    bool done = false;
+    while (!done && cycles < 5000) {
+        tb.tick();
+        cycles++;
+        skipped += chip_top_util::fast_forward_timer(tb.get_dut());
+        done = tb.read_register(0, 11) != 0 && tb.read_register(1, 11) != 0;
+    }
+    for (int i = 0; i < 20; i++) tb.tick();
+    printf("[TB] Woke after %d simulated cycles, %llu skipped (mtime = %llu)\n",
+           cycles, (unsigned long long)skipped, (unsigned long long)tb.get_mtime());
+
+    CHECK(done);
+    CHECK(skipped > 990000);
+    CHECK(tb.get_mtime() >= 0xF4000);
+
+    for (int tile = 0; tile < 2; tile++) {
+        INFO("Tile " << tile);
+        CHECK(tb.read_register(tile, 10) == 1);    // One interrupt taken
+        CHECK(tb.read_register(tile, 12) == 0x2C); // mepc points past the WFI
+        CHECK(tb.read_register(tile, 11) == 1);    // The instruction after WFI ran once
+    }
+}
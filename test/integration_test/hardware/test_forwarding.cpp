@@ -18,10 +18,17 @@
 // ...
 // 0x80: ADDI x10, x0, 1      (Success marker)
 // 0x84: EBREAK
+//
+// "Forwarding Across Pipes" runs a loop of independent ALU pairs whose results are
+// consumed from MEM and WB of both pipes (built with and without DUAL_ISSUE).
 
 #include <Vchip_top.h>
 #include <Vchip_top___024root.h>
 
+#ifndef DUAL_ISSUE
+#define DUAL_ISSUE 0
+#endif
+
 class ChipTopTestbench : public ClockedTestbench<Vchip_top> {
 public:
     ChipTopTestbench() : ClockedTestbench<Vchip_top>(100, true, "dump.vcd") {
@@ -47,6 +54,10 @@ public:
     uint32_t get_pc_ex() {
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
     }
+
+    uint32_t dual_issues() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__dual_issue_count;
+    }
     void do_reset() {
         dut->rst_n = 0;
         for (int i = 0; i < 20; i++) tick();
@@ -104,3 +115,55 @@ ChipTopTestbench tb;
     uint32_t x10 = tb.read_register(10);
     CHECK(x10 == 1);
 }
+
+TEST_CASE("Forwarding Across Pipes") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0x00400513, // 0x00 ADDI x10, x0, 4   (loop counter)
+        0x00000593, // 0x04 ADDI x11, x0, 0   (sum)
+        0x00100093, // 0x08 ADDI x1, x0, 1    (loop: pair)
+        0x00200113, // 0x0c ADDI x2, x0, 2
+        0x002081b3, // 0x10 ADD  x3, x1, x2   (x1 and x2 from MEM of either pipe)
+        0x00400213, // 0x14 ADDI x4, x0, 4
+        0x004182b3, // 0x18 ADD  x5, x3, x4
+        0x00410333, // 0x1c ADD  x6, x2, x4   (x2 from WB)
+        0x005585b3, // 0x20 ADD  x11, x11, x5
+        0xfff50513, // 0x24 ADDI x10, x10, -1
+        0xfe0510e3, // 0x28 BNE  x10, x0, -32
+        0x00100073, // 0x2c EBREAK
+        0x00000013, // NOP
+        0x00000013, // NOP
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until EBREAK (PC = 0x2C = 44)
+    bool ebreak_reached = false;
+    int cycles = 0;
+    for (; cycles < 1000; cycles++) {
+        tb.tick();
+        if (tb.get_pc_ex() == 44) {
+            ebreak_reached = true;
+            for (int i = 0; i < 10; i++) tb.tick();
+            break;
+        }
+    }
+
+    printf("[TB] EBREAK after %d cycles, %u dual-issue cycles\n", cycles, tb.dual_issues());
+
+    CHECK(ebreak_reached == true);
+    CHECK(tb.read_register(3) == 3);
+    CHECK(tb.read_register(5) == 7);
+    CHECK(tb.read_register(6) == 6);
+    CHECK(tb.read_register(10) == 0);
+    CHECK(tb.read_register(11) == 28);
+
+    // Once the loop is in the I-Cache, its ALU pairs issue together
+#if DUAL_ISSUE
+    CHECK(tb.dual_issues() > 0);
+#else
+    CHECK(tb.dual_issues() == 0);
+#endif
+}
@@ -13,6 +13,14 @@
 // - LW x7, 0(x6)       (x7 = 70)
 // - ADD x8, x7, x1     (x8 = 80) (Load-Use Hazard on x7)
 // - EBREAK
+//
+// Branch operands (early branch resolution): a branch whose producers have
+// reached MEM/WB resolves in ID; one right behind its producer, or one
+// behind a load still in MEM, resolves in EX.
+
+#ifndef BRANCH_RESOLVE_DECODE
+#define BRANCH_RESOLVE_DECODE 1
+#endif
 
 #include <Vchip_top.h>
 #include <Vchip_top___024root.h>
@@ -42,6 +50,15 @@ public:
     uint32_t get_pc_ex() {
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
     }
+
+    uint32_t branch_redirects_decode() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__branch_redirect_decode_count;
+    }
+
+    uint32_t branch_redirects_execute() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__branch_redirect_execute_count;
+    }
+
     void do_reset() {
         dut->rst_n = 0;
         for (int i = 0; i < 20; i++) tick();
@@ -94,3 +111,62 @@ ChipTopTestbench tb;
     CHECK(tb.read_register(7) == 70);
     CHECK(tb.read_register(8) == 80);
 }
+
+TEST_CASE("Hazards Branch Operands") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0x00500093, // 0x00 ADDI x1, x0, 5
+        0x00500113, // 0x04 ADDI x2, x0, 5
+        0x00000013, // 0x08 NOP
+        0x00208463, // 0x0c BEQ x1, x2, +8    (x2 in MEM, x1 in WB: resolves in ID)
+        0x00100193, // 0x10 ADDI x3, x0, 1    (skipped)
+        0x00200213, // 0x14 ADDI x4, x0, 2
+        0x00700293, // 0x18 ADDI x5, x0, 7
+        0x00029463, // 0x1c BNE x5, x0, +8    (x5 in EX: resolves in EX)
+        0x00100313, // 0x20 ADDI x6, x0, 1    (skipped)
+        0x00002383, // 0x24 LW x7, 0(x0)
+        0x00000013, // 0x28 NOP
+        0x00039463, // 0x2c BNE x7, x0, +8    (load in MEM: resolves in EX)
+        0x00100413, // 0x30 ADDI x8, x0, 1    (skipped)
+        0x00300493, // 0x34 ADDI x9, x0, 3
+        0x00100073, // 0x38 EBREAK
+        0x00000013, // NOP
+        0x00000013, // NOP
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until EBREAK (PC = 0x38 = 56)
+    bool ebreak_reached = false;
+    int cycles = 0;
+    for (; cycles < 1000; cycles++) {
+        tb.tick();
+        if (tb.get_pc_ex() == 56) {
+            ebreak_reached = true;
+            for (int i = 0; i < 10; i++) tb.tick();
+            break;
+        }
+    }
+
+    printf("[TB] EBREAK after %d cycles, branch redirects: %u from ID, %u from EX\n",
+           cycles, tb.branch_redirects_decode(), tb.branch_redirects_execute());
+
+    CHECK(ebreak_reached == true);
+    CHECK(tb.read_register(3) == 0);
+    CHECK(tb.read_register(4) == 2);
+    CHECK(tb.read_register(6) == 0);
+    CHECK(tb.read_register(7) == 0x00500093);
+    CHECK(tb.read_register(8) == 0);
+    CHECK(tb.read_register(9) == 3);
+
+    // All three branches are taken and miss in the BTB (predicted not taken)
+#if BRANCH_RESOLVE_DECODE
+    CHECK(tb.branch_redirects_decode() == 1);
+    CHECK(tb.branch_redirects_execute() == 2);
+#else
+    CHECK(tb.branch_redirects_decode() == 0);
+    CHECK(tb.branch_redirects_execute() == 3);
+#endif
+}
@@ -11,11 +11,16 @@
 // - ADDI x6, x0, 7    (x6 = 7)
 // - REM x7, x4, x6    (x7 = 2)
 // - EBREAK
-// Note: MDU operations take ~32 cycles each
+// Note: divides take 1-18 cycles (radix-4, early terminating); multiplies take MUL_LATENCY cycles
+// (built once per latency, MDU_MUL_LATENCY)
 
 #include <Vchip_top.h>
 #include <Vchip_top___024root.h>
 
+#ifndef MDU_MUL_LATENCY
+#define MDU_MUL_LATENCY 1
+#endif
+
 class ChipTopTestbench : public ClockedTestbench<Vchip_top> {
 public:
     ChipTopTestbench() : ClockedTestbench<Vchip_top>(100, true, "dump.vcd") {
@@ -41,6 +46,18 @@ public:
     uint32_t get_pc_ex() {
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
     }
+
+    bool mdu_stall() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__mdu_stall;
+    }
+
+    bool hazard_stall() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__stall_hazard;
+    }
+
+    bool divider_busy() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_mdu__DOT__busy;
+    }
     void do_reset() {
         dut->rst_n = 0;
         for (int i = 0; i < 20; i++) tick();
@@ -70,7 +87,7 @@ ChipTopTestbench tb;
     tb.do_reset();
 
     // Run until EBREAK (PC = 0x1C = 28)
-    // MDU operations take ~32 cycles each. 3 MDU ops = ~100 cycles.
+    // Divides finish in a few cycles for small operands; well under 1000 cycles in total.
     bool ebreak_reached = false;
     for (int cycles = 0; cycles < 1000; cycles++) {
         tb.tick();
@@ -90,3 +107,113 @@ ChipTopTestbench tb;
     CHECK(tb.read_register(5) == 20);
     CHECK(tb.read_register(7) == 2);
 }
+
+TEST_CASE("Mdu Back-to-Back Multiply") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0xffd00093, // ADDI x1, x0, -3
+        0x00700113, // ADDI x2, x0, 7
+        0x800001b7, // LUI x3, 0x80000
+        0x02208533, // MUL x10, x1, x2
+        0x022095b3, // MULH x11, x1, x2
+        0x0220a633, // MULHSU x12, x1, x2
+        0x0220b6b3, // MULHU x13, x1, x2
+        0x02218733, // MUL x14, x3, x2
+        0x023197b3, // MULH x15, x3, x3
+        0x0221b833, // MULHU x16, x3, x2
+        0x0211a8b3, // MULHSU x17, x3, x1
+        0x02250933, // MUL x18, x10, x2
+        0x022909b3, // MUL x19, x18, x2 (forwarded from the previous MUL)
+        0x00100073, // EBREAK
+        0x00000013, // NOP
+        0x00000013, // NOP
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until EBREAK (PC = 0x34 = 52), counting cycles the MDU holds EX and
+    // cycles ID waits on the scoreboard
+    bool ebreak_reached = false;
+    int mdu_stall_cycles = 0;
+    int hazard_stall_cycles = 0;
+    for (int cycles = 0; cycles < 1000; cycles++) {
+        if (tb.mdu_stall()) mdu_stall_cycles++;
+        if (tb.hazard_stall()) hazard_stall_cycles++;
+        tb.tick();
+
+        if (tb.get_pc_ex() == 52) {
+            ebreak_reached = true;
+            for (int i = 0; i < 10; i++) tb.tick();
+            break;
+        }
+    }
+
+    CHECK(ebreak_reached == true);
+
+    // Multiplies never hold EX; only MUL x19 waits (in ID) for the x18 it reads
+    printf("[TB] MUL_LATENCY=%d: %d MDU stall cycles, %d scoreboard stall cycles for 10 multiplies\n",
+           MDU_MUL_LATENCY, mdu_stall_cycles, hazard_stall_cycles);
+    CHECK(mdu_stall_cycles == 0);
+    CHECK(hazard_stall_cycles <= MDU_MUL_LATENCY);
+
+    CHECK(tb.read_register(10) == 0xFFFFFFEB); // -21
+    CHECK(tb.read_register(11) == 0xFFFFFFFF);
+    CHECK(tb.read_register(12) == 0xFFFFFFFF);
+    CHECK(tb.read_register(13) == 6);
+    CHECK(tb.read_register(14) == 0x80000000);
+    CHECK(tb.read_register(15) == 0x40000000);
+    CHECK(tb.read_register(16) == 3);
+    CHECK(tb.read_register(17) == 0x80000001);
+    CHECK(tb.read_register(18) == 0xFFFFFF6D); // -147
+    CHECK(tb.read_register(19) == 0xFFFFFBFB); // -1029
+}
+
+TEST_CASE("Mdu Non-Blocking Divide") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0x3e800213, // ADDI x4, x0, 1000
+        0x00700113, // ADDI x2, x0, 7
+        0x022242b3, // DIV x5, x4, x2      (x5 = 142)
+        0x00100313, // ADDI x6, x0, 1      (independent, overlaps the divide)
+        0x00200393, // ADDI x7, x0, 2
+        0x00300413, // ADDI x8, x0, 3
+        0x00400493, // ADDI x9, x0, 4
+        0x00628533, // ADD x10, x5, x6     (waits for the divide)
+        0x00100073, // EBREAK
+        0x00000013, // NOP
+        0x00000013, // NOP
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until EBREAK (PC = 0x20 = 32), counting independent instructions in EX while the divider runs
+    bool ebreak_reached = false;
+    int mdu_stall_cycles = 0;
+    int overlap_cycles = 0;
+    for (int cycles = 0; cycles < 1000; cycles++) {
+        uint32_t pc_ex = tb.get_pc_ex();
+        if (tb.mdu_stall()) mdu_stall_cycles++;
+        if (tb.divider_busy() && pc_ex >= 0x0C && pc_ex <= 0x18) overlap_cycles++;
+        tb.tick();
+
+        if (tb.get_pc_ex() == 32) {
+            ebreak_reached = true;
+            for (int i = 0; i < 10; i++) tb.tick();
+            break;
+        }
+    }
+
+    CHECK(ebreak_reached == true);
+    printf("[TB] %d cycles of independent work overlapped the divide\n", overlap_cycles);
+    CHECK(mdu_stall_cycles == 0);
+    CHECK(overlap_cycles > 0);
+
+    CHECK(tb.read_register(5) == 142);
+    CHECK(tb.read_register(6) == 1);
+    CHECK(tb.read_register(9) == 4);
+    CHECK(tb.read_register(10) == 143);
+}
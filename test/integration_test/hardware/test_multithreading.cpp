@@ -0,0 +1,195 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "tb_base.h"
+// Test: Switch-on-miss Hardware Multithreading (chip_top built with THREADS=2)
+// Every hart sums 16 words of its own array, one cache line apart, so each load misses:
+// - CSRRS x10, mhartid, x0  (x10 = hart h: 0/1 on tile 0, 2/3 on tile 1)
+// - x12 = 0x1000 + h*256, x13 = 16, x14 = 0
+// - loop: LW x15, 0(x12); ADD x14, x14, x15; ADDI x12, x12, 16; ADDI x13, x13, -1; BNE x13, x0, loop
+// - SW x14, 0x700(h*4)     (Mem[0x700 + h*4] = sum)
+// - EBREAK
+// - Keep missing (walk memory from 0x4000) so the sibling context still gets the core
+// Test: WFI switches context
+// - Context 0 (even harts) enables its timer interrupt (mstatus.MIE stays clear), arms the
+//   timer at 0xF4000 and executes WFI, then stores 0x456 at Mem[0x700 + h*4]
+// - Context 1 (odd harts) stores 0x123 at Mem[0x700 + h*4] and waits on WFI with no interrupt
+//   enabled
+// Context 1 must run while context 0 waits; once both wait the core parks (the testbench
+// fast-forwards the timer), and the timer interrupt resumes context 0 at its WFI.
+
+#include <Vchip_top.h>
+#include <Vchip_top___024root.h>
+#include "chip_top_idle.h"
+
+static constexpr int HARTS = 4;       // 2 tiles x 2 contexts
+static constexpr int ARRAY_WORDS = 16;
+
+class ChipTopTestbench : public ClockedTestbench<Vchip_top> {
+public:
+    ChipTopTestbench() : ClockedTestbench<Vchip_top>(100, true, "dump.vcd") {
+        dut->rst_n = 0;
+    }
+
+public:
+    void set_clk(uint8_t value) override {
+        dut->clk = value;
+    }
+
+    void load_program(const std::vector<uint32_t>& program) {
+        for (size_t i = 0; i < program.size(); i++) {
+            dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[i] = program[i];
+        }
+    }
+
+    void write_memory(uint32_t address, uint32_t value) {
+        dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[address / 4] = value;
+    }
+
+    uint32_t read_memory(uint32_t address) {
+        return dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[address / 4];
+    }
+
+    // Register of a context on tile 0
+    uint32_t read_register(int context, int reg_idx) {
+        if (reg_idx < 0 || reg_idx >= 32) return 0;
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_regfile__DOT__registers[32 * context + reg_idx];
+    }
+
+    uint32_t get_switch_count() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__thread_switch_count;
+    }
+
+    void do_reset() {
+        dut->rst_n = 0;
+        for (int i = 0; i < 20; i++) tick();
+        dut->rst_n = 1;
+        for (int i = 0; i < 5; i++) tick();
+    }
+};
+
+TEST_CASE("Multithreading") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0xf1402573, // 00: CSRRS x10, mhartid, x0
+        0x00851593, // 04: SLLI x11, x10, 8
+        0x00001637, // 08: LUI x12, 0x1
+        0x00b60633, // 0C: ADD x12, x12, x11
+        0x01000693, // 10: ADDI x13, x0, 16
+        0x00000713, // 14: ADDI x14, x0, 0
+        0x00062783, // 18: LW x15, 0(x12)
+        0x00f70733, // 1C: ADD x14, x14, x15
+        0x01060613, // 20: ADDI x12, x12, 16
+        0xfff68693, // 24: ADDI x13, x13, -1
+        0xfe0698e3, // 28: BNE x13, x0, -16
+        0x00251813, // 2C: SLLI x16, x10, 2
+        0x70e82023, // 30: SW x14, 0x700(x16)
+        0x00100073, // 34: EBREAK
+        0x00004937, // 38: LUI x18, 0x4
+        0x00092883, // 3C: LW x17, 0(x18)
+        0x01090913, // 40: ADDI x18, x18, 16
+        0xff9ff06f, // 44: JAL x0, -8
+    };
+
+    tb.load_program(program);
+
+    // Hart h's array: word i = (h + 1) * 100 + i
+    for (int h = 0; h < HARTS; h++) {
+        for (int i = 0; i < ARRAY_WORDS; i++) {
+            tb.write_memory(0x1000 + h * 256 + i * 16, (h + 1) * 100 + i);
+        }
+    }
+
+    tb.do_reset();
+
+    // Run until every hart stored its sum
+    int cycles = 0;
+    bool done = false;
+    while (!done && cycles < 20000) {
+        tb.tick();
+        cycles++;
+        done = true;
+        for (int h = 0; h < HARTS; h++) {
+            if (tb.read_memory(0x700 + h * 4) == 0) done = false;
+        }
+    }
+    printf("[TB] All harts done after %d cycles, %u thread switches on tile 0\n", cycles, tb.get_switch_count());
+
+    CHECK(done);
+    for (int h = 0; h < HARTS; h++) {
+        INFO("Hart " << h);
+        CHECK(tb.read_memory(0x700 + h * 4) == 1600u * (h + 1) + 120);
+    }
+
+    // Both contexts ran on tile 0, each in its own register bank with its own mhartid
+    CHECK(tb.get_switch_count() > 0);
+    CHECK(tb.read_register(0, 10) == 0);
+    CHECK(tb.read_register(1, 10) == 1);
+    CHECK(tb.read_register(0, 14) == 1720);
+    CHECK(tb.read_register(1, 14) == 3320);
+}
+
+TEST_CASE("Multithreading WFI") {
+ChipTopTestbench tb;
+
+    std::vector<uint32_t> program = {
+        0xf1402573, // 00: CSRRS x10, mhartid, x0
+        0x00157593, // 04: ANDI x11, x10, 1
+        0x00251813, // 08: SLLI x16, x10, 2
+        0x02059463, // 0C: BNE x11, x0, +0x28 (context 1)
+        0x08000093, // 10: ADDI x1, x0, 0x80
+        0x3040a073, // 14: CSRRS x0, mie, x1 (MTIE)
+        0x400040b7, // 18: LUI x1, 0x40004
+        0x000f4137, // 1C: LUI x2, 0xF4
+        0x0000a623, // 20: SW x0, 12(x1) (mtimecmp high = 0)
+        0x0020a423, // 24: SW x2, 8(x1) (mtimecmp low = 0xF4000)
+        0x10500073, // 28: WFI
+        0x45600713, // 2C: ADDI x14, x0, 0x456
+        0x0140006f, // 30: JAL x0, +0x14
+        0x12300713, // 34: ADDI x14, x0, 0x123
+        0x70e82023, // 38: SW x14, 0x700(x16)
+        0x10500073, // 3C: WFI
+        0xffdff06f, // 40: JAL x0, -4
+        0x70e82023, // 44: SW x14, 0x700(x16)
+        0x0000006f, // 48: JAL x0, 0
+    };
+
+    tb.load_program(program);
+    tb.do_reset();
+
+    // Run until every hart stored, fast-forwarding the timer once every context waits
+    uint64_t skipped = 0;
+    int cycles = 0;
+    bool done = false;
+    while (!done && cycles < 5000) {
+        tb.tick();
+        cycles++;
+        uint64_t jump = chip_top_util::fast_forward_timer(tb.get_dut());
+        if (jump && !skipped) {
+            // Parked: the odd harts ran while the even harts waited
+            for (int h = 0; h < HARTS; h++) {
+                INFO("Hart " << h << " when parked");
+                CHECK(tb.read_memory(0x700 + h * 4) == (h % 2 ? 0x123u : 0u));
+            }
+        }
+        skipped += jump;
+        done = true;
+        for (int h = 0; h < HARTS; h++) {
+            if (tb.read_memory(0x700 + h * 4) == 0) done = false;
+        }
+    }
+    printf("[TB] All harts done after %d cycles, %llu skipped, %u thread switches on tile 0\n",
+           cycles, (unsigned long long)skipped, tb.get_switch_count());
+
+    CHECK(done);
+    CHECK(skipped > 0);
+    for (int h = 0; h < HARTS; h++) {
+        INFO("Hart " << h);
+        CHECK(tb.read_memory(0x700 + h * 4) == (h % 2 ? 0x123u : 0x456u));
+    }
+
+    // Context 0 -> 1 on its WFI, back to 0 on its timer interrupt; context 1 still waits
+    CHECK(tb.get_switch_count() == 2);
+    CHECK(tb.read_register(0, 14) == 0x456);
+    CHECK(tb.read_register(1, 14) == 0x123);
+}
@@ -0,0 +1,43 @@
+#include "chip_top_testbench.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Host-thread scaling benchmark
+// Runs the Fibonacci and CSR programs on chip_top verilated with --threads MODEL_THREADS and
+// reports simulated cycles/s. Each program runs for a fixed number of cycles (argv[1], default
+// 2000000); once done, both harts spin in the final loop of start.S.
+// The process is pinned to host CPUs 0 .. MODEL_THREADS - 1.
+
+// Run one program; returns whether it produced its expected result
+static bool run(const char* name, int result_reg, uint32_t expected, uint64_t cycles) {
+    ChipTopTestbench tb;
+    tb.load_program(std::string(PROGRAM_DIR) + "/" + name + ".bin");
+    tb.do_reset();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < cycles; i++) {
+        tb.tick();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    bool pass = tb.read_reg(result_reg) == expected;
+    printf("[BENCH] %-16s threads=%d: %.0f cycles/s (%llu cycles in %.3f s)%s\n",
+           name, MODEL_THREADS, cycles / elapsed.count(), (unsigned long long)cycles, elapsed.count(),
+           pass ? "" : " WRONG RESULT");
+    return pass;
+}
+
+int main(int argc, char** argv) {
+    uint64_t cycles = (argc > 1) ? strtoull(argv[1], nullptr, 0) : 2000000;
+
+    if (!TestbenchBase<Vchip_top>::set_thread_affinity(0, MODEL_THREADS)) {
+        printf("[BENCH] Thread affinity not set (unpinned run)\n");
+    }
+
+    bool pass = true;
+    pass &= run("test_fibonacci", 10, 55, cycles);     // a0 = fibonacci(10)
+    pass &= run("test_csr", 20, 0x12345678, cycles);   // s4 set after the trap returned
+    return pass ? 0 : 1;
+}
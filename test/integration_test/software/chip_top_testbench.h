@@ -0,0 +1,67 @@
+#pragma once
+
+#include "tb_base.h"
+#include "program_loader.h"
+#include <Vchip_top.h>
+#include <Vchip_top___024root.h>
+#include <string>
+
+// chip_top testbench shared by the software tests, benchmarks and runners: loads a program
+// image into main memory, resets the chip and reads hart 0's state. Tests that need more of
+// the hierarchy derive from it.
+class ChipTopTestbench : public ClockedTestbench<Vchip_top> {
+public:
+    ChipTopTestbench(bool enable_trace = false, const std::string& trace_filename = "dump.vcd")
+        : ClockedTestbench<Vchip_top>(100, enable_trace, trace_filename) {
+        dut->rst_n = 0;
+    }
+
+    void set_clk(uint8_t value) override {
+        dut->clk = value;
+    }
+
+    // Returns the number of words loaded
+    size_t load_program(const std::string& bin_path) {
+        auto program = ProgramLoader::load_binary(bin_path);
+
+        for (size_t i = 0; i < program.size(); i++) {
+            dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[i] = program[i];
+        }
+        return program.size();
+    }
+
+    uint32_t read_reg(int idx) {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_regfile__DOT__registers[idx];
+    }
+
+    uint32_t get_pc() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
+    }
+
+    uint32_t get_instruction() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__if_id_instruction;
+    }
+
+#ifndef CHIP_TOP_FAST
+    // Not used by the fast flavour, which is verilated without --public
+    uint64_t get_instret() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_control_status_register_file__DOT__minstret;
+    }
+
+    // PC of the instruction in IF/ID
+    uint32_t get_fetch_pc() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__if_id_program_counter;
+    }
+#endif
+
+    bool is_ebreak() {
+        return get_instruction() == 0x00100073;
+    }
+
+    void do_reset() {
+        dut->rst_n = 0;
+        for (int i = 0; i < 20; i++) tick();
+        dut->rst_n = 1;
+        for (int i = 0; i < 5; i++) tick();
+    }
+};
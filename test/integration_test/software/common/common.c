@@ -97,3 +97,20 @@ void csr_write(int csr_num, reg_t val) {
         asm volatile ("csrw mie, %0" : : "r"(val));
     }
 }
+
+// cycle/instret are the read-only user copies of mcycle/minstret
+uint32_t rdcycle(void) {
+    uint32_t result;
+    asm volatile ("csrr %0, 0xc00" : "=r"(result));
+    return result;
+}
+
+uint32_t rdinstret(void) {
+    uint32_t result;
+    asm volatile ("csrr %0, 0xc02" : "=r"(result));
+    return result;
+}
+
+void wfi(void) {
+    asm volatile ("wfi");
+}
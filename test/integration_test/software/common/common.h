@@ -12,6 +12,21 @@
 #define CSR_MTVEC   0x305
 #define CSR_MEPC    0x341
 #define CSR_MCAUSE  0x342
+#define CSR_MCOUNTINHIBIT 0x320
+#define CSR_MHPMEVENT3    0x323 // mhpmevent3..10 at 0x323..0x32A
+#define CSR_MCYCLE        0xB00
+#define CSR_MINSTRET      0xB02
+#define CSR_MHPMCOUNTER3  0xB03 // mhpmcounter3..10 at 0xB03..0xB0A
+
+// mhpmevent values
+#define HPM_EVENT_ICACHE_MISS   1
+#define HPM_EVENT_DCACHE_MISS   2
+#define HPM_EVENT_L2_MISS       3
+#define HPM_EVENT_MISPREDICT    4
+#define HPM_EVENT_LOAD_USE      5
+#define HPM_EVENT_MDU_STALL     6
+#define HPM_EVENT_BUS_WAIT      7
+#define HPM_EVENT_TRAP          8
 
 // Types
 typedef unsigned int uint32_t;
@@ -32,4 +47,11 @@ unsigned int umod(unsigned int num, unsigned int den);
 reg_t csr_read(int csr_num);
 void csr_write(int csr_num, reg_t val);
 
+// Counter Helpers (user-mode aliases of mcycle and minstret, low 32 bits)
+uint32_t rdcycle(void);
+uint32_t rdinstret(void);
+
+// Idle: park the hart until an enabled interrupt is pending (instead of spin-polling)
+void wfi(void);
+
 #endif // COMMON_H
@@ -0,0 +1,35 @@
+#include "chip_top_testbench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// PGO training run (CHIP_TOP_PGO)
+// Usage: pgo_train <cycles> <program.bin>... [+verilator+... plusargs]
+// Runs each program on one chip_top model for a fixed number of cycles, reloading memory and
+// resetting in between. The instrumented model writes its profile when the process exits:
+// profile.vlt for a --prof-pgo model (+verilator+prof+vlt+file+ names it), or the compiler's
+// raw profile for a -fprofile-instr-generate build.
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <cycles> <program.bin>...\n", argv[0]);
+        return 1;
+    }
+    uint64_t cycles = strtoull(argv[1], nullptr, 0);
+
+    ChipTopTestbench tb;
+    for (int i = 2; i < argc; i++) {
+        if (argv[i][0] == '+') tb.add_plusarg(argv[i]);
+    }
+    for (int i = 2; i < argc; i++) {
+        if (argv[i][0] == '+') continue;
+
+        tb.load_program(argv[i]);
+        tb.do_reset();
+        for (uint64_t c = 0; c < cycles; c++) {
+            tb.tick();
+        }
+        printf("[PGO] Trained on %s (%llu cycles)\n", argv[i], (unsigned long long)cycles);
+    }
+    return 0;
+}
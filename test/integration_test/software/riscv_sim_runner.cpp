@@ -0,0 +1,226 @@
+#include "chip_top_testbench.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Batch regression runner
+// Usage: riscv_sim_runner <manifest> [--program-dir <dir>] [--jobs <n>] [--json <file>]
+// Runs every program listed in the manifest on its own chip_top model, on a pool of host
+// threads (--jobs, default one per host core), and writes a JSON summary (--json).
+//
+// Manifest: one workload per line, '#' starts a comment
+//   <name> <program.bin> <max_cycles> [end=<pc>] x<reg>=<value>...
+// A program ends when hart 0 has EBREAK in IF/ID, or the instruction at end=<pc> if given
+// (as in test_fibonacci). Hart 0's listed registers are compared at that point; a program
+// that has not ended after max_cycles times out. Relative program paths are resolved
+// against --program-dir (default: the manifest's directory).
+
+struct Expectation {
+    int reg;
+    uint32_t value;
+};
+
+struct Workload {
+    std::string name;
+    std::string program;
+    uint64_t max_cycles = 0;
+    bool has_end_pc = false; // Otherwise the program ends at EBREAK
+    uint32_t end_pc = 0;
+    std::vector<Expectation> expect;
+};
+
+struct Result {
+    std::string status = "error"; // pass, fail (wrong registers), timeout or error (program not loaded)
+    std::string message;
+    uint64_t cycles = 0;
+    uint64_t instret = 0;
+    double wall_time = 0;
+};
+
+static std::vector<Workload> parse_manifest(const std::string& path, const std::string& program_dir) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open manifest: " + path);
+    }
+
+    std::vector<Workload> workloads;
+    std::string line;
+    for (int line_no = 1; std::getline(file, line); line_no++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        Workload work;
+        if (!(fields >> work.name)) continue; // Blank or comment line
+
+        std::string cycles;
+        if (!(fields >> work.program >> cycles)) {
+            throw std::runtime_error(path + ":" + std::to_string(line_no) + ": expected <name> <program.bin> <max_cycles>");
+        }
+        work.max_cycles = strtoull(cycles.c_str(), nullptr, 0);
+        if (work.program[0] != '/') {
+            work.program = program_dir + "/" + work.program;
+        }
+
+        std::string term;
+        while (fields >> term) {
+            if (term.compare(0, 4, "end=") == 0) {
+                work.has_end_pc = true;
+                work.end_pc = strtoul(term.c_str() + 4, nullptr, 0);
+                continue;
+            }
+            size_t eq = term.find('=');
+            int reg = (term[0] == 'x' && eq != std::string::npos) ? atoi(term.substr(1, eq - 1).c_str()) : -1;
+            if (reg < 1 || reg > 31) {
+                throw std::runtime_error(path + ":" + std::to_string(line_no) + ": bad expectation '" + term + "' (want x<reg>=<value>)");
+            }
+            work.expect.push_back({reg, (uint32_t)strtoul(term.substr(eq + 1).c_str(), nullptr, 0)});
+        }
+        if (work.expect.empty()) {
+            throw std::runtime_error(path + ":" + std::to_string(line_no) + ": no expected result for " + work.name);
+        }
+        workloads.push_back(work);
+    }
+    return workloads;
+}
+
+static Result run(const Workload& work) {
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+
+    ChipTopTestbench tb;
+    try {
+        tb.load_program(work.program);
+    } catch (const std::exception& e) {
+        result.message = e.what();
+        return result;
+    }
+    tb.do_reset();
+
+    bool ended = false;
+    while (!ended && result.cycles < work.max_cycles) {
+        tb.tick();
+        result.cycles++;
+        ended = work.has_end_pc ? tb.get_fetch_pc() == work.end_pc : tb.is_ebreak();
+    }
+
+    std::ostringstream message;
+    if (!ended) {
+        result.status = "timeout";
+        if (work.has_end_pc) {
+            message << "PC 0x" << std::hex << work.end_pc << std::dec << " not reached";
+        } else {
+            message << "no EBREAK";
+        }
+        message << " after " << work.max_cycles << " cycles";
+    } else {
+        for (const auto& expect : work.expect) {
+            if (tb.read_reg(expect.reg) != expect.value) {
+                if (message.tellp() > 0) message << ", ";
+                message << "x" << expect.reg << "=0x" << std::hex << tb.read_reg(expect.reg)
+                        << " (expected 0x" << expect.value << ")" << std::dec;
+            }
+        }
+        result.status = (message.tellp() > 0) ? "fail" : "pass";
+    }
+    result.message = message.str();
+    result.instret = tb.get_instret();
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static std::string json_string(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+static void write_json(const std::string& path, const std::string& manifest, const std::vector<Workload>& workloads,
+                       const std::vector<Result>& results, int passed, double wall_time) {
+    std::ofstream out(path);
+    char number[64];
+    snprintf(number, sizeof(number), "%.6f", wall_time);
+    out << "{\n"
+        << "  \"manifest\": " << json_string(manifest) << ",\n"
+        << "  \"total\": " << results.size() << ",\n"
+        << "  \"passed\": " << passed << ",\n"
+        << "  \"failed\": " << results.size() - passed << ",\n"
+        << "  \"wall_time_s\": " << number << ",\n"
+        << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        snprintf(number, sizeof(number), "%.6f", results[i].wall_time);
+        out << "    {\"name\": " << json_string(workloads[i].name)
+            << ", \"program\": " << json_string(workloads[i].program)
+            << ", \"status\": " << json_string(results[i].status)
+            << ", \"cycles\": " << results[i].cycles
+            << ", \"instret\": " << results[i].instret
+            << ", \"wall_time_s\": " << number
+            << ", \"message\": " << json_string(results[i].message)
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    std::string manifest, program_dir, json_path;
+    unsigned jobs = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--program-dir" && i + 1 < argc) {
+            program_dir = argv[++i];
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            jobs = strtoul(argv[++i], nullptr, 0);
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (manifest.empty() && arg[0] != '-') {
+            manifest = arg;
+        } else {
+            manifest.clear();
+            break;
+        }
+    }
+    if (manifest.empty()) {
+        fprintf(stderr, "Usage: %s <manifest> [--program-dir <dir>] [--jobs <n>] [--json <file>]\n", argv[0]);
+        return 2;
+    }
+    if (program_dir.empty()) {
+        size_t slash = manifest.find_last_of('/');
+        program_dir = (slash == std::string::npos) ? "." : manifest.substr(0, slash);
+    }
+
+    std::vector<Workload> workloads;
+    try {
+        workloads = parse_manifest(manifest, program_dir);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "[RUNNER] %s\n", e.what());
+        return 2;
+    }
+
+    std::vector<Result> results(workloads.size());
+    auto start = std::chrono::steady_clock::now();
+    tb_util::run_parallel(workloads.size(), [&](size_t i) {
+        results[i] = run(workloads[i]);
+    }, jobs);
+    double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int passed = 0;
+    for (size_t i = 0; i < workloads.size(); i++) {
+        const Result& r = results[i];
+        passed += r.status == "pass";
+        printf("[RUNNER] %-7s %-20s %10llu cycles %10llu instret %8.3f s %s\n",
+               r.status.c_str(), workloads[i].name.c_str(), (unsigned long long)r.cycles,
+               (unsigned long long)r.instret, r.wall_time, r.message.c_str());
+    }
+    printf("[RUNNER] %d/%zu passed in %.3f s\n", passed, workloads.size(), wall_time);
+
+    if (!json_path.empty()) {
+        write_json(json_path, manifest, workloads, results, passed, wall_time);
+    }
+    return passed == (int)workloads.size() ? 0 : 1;
+}
@@ -1,45 +1,14 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
-#include "tb_base.h"
-#include "program_loader.h"
-#include <Vchip_top.h>
-#include <Vchip_top___024root.h>
+#include "chip_top_testbench.h"
 #include <cstdio>
 #include <cstdlib>
 #include <string>
 
-class CsrTestbench : public ClockedTestbench<Vchip_top> {
+class CsrTestbench : public ChipTopTestbench {
 public:
-    CsrTestbench() : ClockedTestbench<Vchip_top>(100, true, "dump.vcd") {
-        dut->rst_n = 0;
-    }
+    CsrTestbench() : ChipTopTestbench(true, "dump.vcd") {}
 
-    void set_clk(uint8_t value) override { 
-        dut->clk = value; 
-    }
-    
-    void load_program(const std::string& bin_path) {
-        auto program = ProgramLoader::load_binary(bin_path);
-        
-        for (size_t i = 0; i < program.size(); i++) {
-            dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[i] = program[i];
-        }
-        
-        printf("Loaded %zu instructions into memory\n", program.size());
-    }
-    
-    uint32_t read_reg(int idx) {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_regfile__DOT__registers[idx];
-    }
-    
-    uint32_t get_pc() {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
-    }
-    
-    uint32_t get_instruction() {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__if_id_instruction;
-    }
-    
     uint32_t get_mcause() {
         return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_control_status_register_file__DOT__mcause;
     }
@@ -51,24 +20,13 @@ public:
     bool is_ecall() {
         return (get_instruction() & 0xFFFFFFFF) == 0x00000073;
     }
-    
-    bool is_ebreak() {
-        return (get_instruction() & 0xFFFFFFFF) == 0x00100073;
-    }
-    
-    void do_reset() {
-        dut->rst_n = 0;
-        for (int i = 0; i < 20; i++) tick();
-        dut->rst_n = 1;
-        for (int i = 0; i < 5; i++) tick();
-    }
 };
 
 TEST_CASE("Csr") {
 CsrTestbench tb;
     
     // Load program binary
-    tb.load_program(PROGRAM_BIN_PATH);
+    printf("Loaded %zu instructions into memory\n", tb.load_program(PROGRAM_BIN_PATH));
     
     // Reset
     tb.do_reset();
@@ -1,62 +1,39 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
-#include "tb_base.h"
-#include "program_loader.h"
-#include <Vchip_top.h>
-#include <Vchip_top___024root.h>
+#include "chip_top_testbench.h"
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
 
-class FibonacciTestbench : public ClockedTestbench<Vchip_top> {
+class FibonacciTestbench : public ChipTopTestbench {
 public:
-    FibonacciTestbench() : ClockedTestbench<Vchip_top>(100, false, "dump.vcd") {  // Disable tracing
-        dut->rst_n = 0;
+#ifndef CHIP_TOP_FAST
+    // Return address stack statistics (returns resolved in EX / predicted correctly)
+    uint32_t ras_returns() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_frontend__DOT__u_return_address_stack__DOT__return_count;
     }
 
-    void set_clk(uint8_t value) override { 
-        dut->clk = value; 
+    uint32_t ras_hits() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_frontend__DOT__u_return_address_stack__DOT__return_hits;
     }
-    
-    void load_program(const std::string& bin_path) {
-        auto program = ProgramLoader::load_binary(bin_path);
-        
-        for (size_t i = 0; i < program.size(); i++) {
-            dut->rootp->chip_top__DOT__u_memory_subsystem__DOT__u_main_memory__DOT__memory[i] = program[i];
-        }
-        
-        printf("Loaded %zu instructions into memory\n", program.size());
-    }
-    
-    uint32_t read_reg(int idx) {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__u_regfile__DOT__registers[idx];
-    }
-    
-    uint32_t get_pc() {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__id_ex_program_counter;
-    }
-    
-    uint32_t get_instruction() {
-        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_backend__DOT__if_id_instruction;
-    }
-    
-    bool is_ebreak() {
-        return (get_instruction() & 0xFFFFFFFF) == 0x00100073;
+
+    // Fetch queue statistics (head waiting for the backend / backend finding the queue empty)
+    uint32_t fetch_queue_backend_stalls() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_frontend__DOT__u_fetch_queue__DOT__backend_stall_cycles;
     }
-    
-    void do_reset() {
-        dut->rst_n = 0;
-        for (int i = 0; i < 20; i++) tick();
-        dut->rst_n = 1;
-        for (int i = 0; i < 5; i++) tick();
+
+    uint32_t fetch_queue_empty() {
+        return dut->rootp->chip_top__DOT__u_tile_0__DOT__u_core__DOT__u_frontend__DOT__u_fetch_queue__DOT__empty_cycles;
     }
+#endif
 };
 
 TEST_CASE("Fibonacci") {
 FibonacciTestbench tb;
     
     // Load program binary
-    tb.load_program(PROGRAM_BIN_PATH);
+    printf("Loaded %zu instructions into memory\n", tb.load_program(PROGRAM_BIN_PATH));
     
     // Reset
     tb.do_reset();
@@ -64,6 +41,7 @@ FibonacciTestbench tb;
     // Run until EBREAK (max 200k cycles)
     bool found_ebreak = false;
     int ebreak_count = 0;
+    auto start = std::chrono::steady_clock::now();
     for (int i = 0; i < 200000; i++) {
         tb.tick();
         
@@ -81,6 +59,16 @@ FibonacciTestbench tb;
                 }
                 
                 fprintf(stderr, "PASS: Fibonacci result = %u\n", result);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                fprintf(stderr, "Simulation speed: %.0f cycles/s (%d cycles in %.3f s)\n",
+                        (i + 1) / elapsed.count(), i + 1, elapsed.count());
+#ifndef CHIP_TOP_FAST
+                fprintf(stderr, "Return prediction: %u/%u hits\n", tb.ras_hits(), tb.ras_returns());
+                fprintf(stderr, "Fetch queue: %u cycles waiting for the backend, %u cycles empty\n",
+                        tb.fetch_queue_backend_stalls(), tb.fetch_queue_empty());
+                CHECK(tb.ras_returns() > 0);
+                CHECK(tb.ras_hits() * 2 > tb.ras_returns());
+#endif
                 found_ebreak = true;
                 break;
             }
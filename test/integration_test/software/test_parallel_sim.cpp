@@ -0,0 +1,69 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "chip_top_testbench.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Many models in one process
+// Runs INSTANCES chip_top models on a pool of host threads, alternating the Fibonacci and CSR
+// programs. Each model has its own VerilatedContext and memory image and runs until its result
+// register holds the expected value. The pool has one worker per host core, divided by the
+// model's own --threads (MODEL_THREADS).
+
+constexpr int INSTANCES = 32;
+constexpr int MAX_CYCLES = 200000;
+
+struct Workload {
+    const char* program;
+    int result_reg;
+    uint32_t expected;
+};
+
+static const Workload WORKLOADS[] = {
+    {"test_fibonacci", 10, 55},          // a0 = fibonacci(10)
+    {"test_csr", 20, 0x12345678},        // s4 set after the trap returned
+};
+
+struct Result {
+    bool pass = false;
+    int cycles = 0;
+};
+
+TEST_CASE("Parallel Simulation") {
+    std::vector<Result> results(INSTANCES);
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency() / MODEL_THREADS);
+
+    auto start = std::chrono::steady_clock::now();
+    tb_util::run_parallel(INSTANCES, [&](size_t i) {
+        const Workload& work = WORKLOADS[i % 2];
+        ChipTopTestbench tb;
+        tb.load_program(std::string(PROGRAM_DIR) + "/" + work.program + ".bin");
+        tb.do_reset();
+
+        Result& result = results[i];
+        while (result.cycles < MAX_CYCLES && !result.pass) {
+            tb.tick();
+            result.cycles++;
+            result.pass = tb.read_reg(work.result_reg) == work.expected;
+        }
+    }, workers);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    uint64_t total_cycles = 0;
+    for (int i = 0; i < INSTANCES; i++) {
+        INFO("Instance " << i << " (" << WORKLOADS[i % 2].program << ")");
+        CHECK(results[i].pass);
+        total_cycles += results[i].cycles;
+    }
+    printf("[TB] %d models on %u threads: %llu cycles in %.3f s (%.0f cycles/s aggregate)\n",
+           INSTANCES, workers, (unsigned long long)total_cycles, elapsed.count(),
+           total_cycles / elapsed.count());
+
+    // Each program finishes in the same number of cycles on every model
+    for (int i = 2; i < INSTANCES; i++) {
+        CHECK(results[i].cycles == results[i % 2].cycles);
+    }
+}
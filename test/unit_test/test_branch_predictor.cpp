@@ -6,19 +6,35 @@
 
 /**
  * Branch Predictor Testbench
- * Tests BTB (Branch Target Buffer) and BHT (Branch History Table)
+ * Tests BTB (Branch Target Buffer) and the gshare direction table
  * Uses 2-bit saturating counter (Weakly/Strongly Not Taken/Taken)
+ * indexed by PC xor global branch history
  */
 class BranchPredictorTestbench : public ClockedTestbench<Vbranch_predictor> {
 public:
+    // Encodings
+    static constexpr uint32_t BEQ_BACK_16 = 0xFE2088E3; // beq x1, x2, -16
+    static constexpr uint32_t BEQ_FWD_16  = 0x00208863; // beq x1, x2, +16
+    static constexpr uint32_t ADDI_NOP    = 0x00000013;
+
     BranchPredictorTestbench() : ClockedTestbench<Vbranch_predictor>(100, false) {
         dut->rst_n = 0;
         dut->program_counter_fetch = 0;
+        dut->instruction_fetch = ADDI_NOP;
         dut->program_counter_execute = 0;
         dut->branch_taken_execute = 0;
         dut->branch_target_execute = 0;
         dut->is_branch_execute = 0;
         dut->is_jump_execute = 0;
+        dut->fetch_advance = 0;
+        dut->history_execute = 0;
+        dut->mispredict_execute = 0;
+        dut->history_decode = 0;
+        dut->is_branch_decode = 0;
+        dut->branch_taken_decode = 0;
+        dut->mispredict_decode = 0;
+        dut->execute_advance = 0;
+        dut->restore = 0;
     }
     
     void set_clk(uint8_t value) override {
@@ -130,6 +146,235 @@ public:
         // Should predict taken with correct target
         check_prediction(pc, true, target, "After jump");
     }
+
+    // One trip of a branch through the pipeline: predicted at fetch, resolved in EX.
+    // Returns whether the prediction was correct.
+    bool run_branch(uint32_t pc, bool taken, uint32_t target) {
+        dut->program_counter_fetch = pc;
+        dut->instruction_fetch = BEQ_FWD_16;
+        eval();
+        bool predicted = dut->prediction_taken;
+        uint32_t history = dut->prediction_history;
+        dut->fetch_advance = 1;
+        tick();
+        dut->fetch_advance = 0;
+        dut->instruction_fetch = ADDI_NOP;
+
+        dut->program_counter_execute = pc;
+        dut->branch_taken_execute = taken ? 1 : 0;
+        dut->branch_target_execute = target;
+        dut->is_branch_execute = 1;
+        dut->history_execute = history;
+        dut->mispredict_execute = (predicted != taken) ? 1 : 0;
+        tick();
+        dut->is_branch_execute = 0;
+        dut->mispredict_execute = 0;
+        eval();
+        return predicted == taken;
+    }
+
+    void test_global_history() {
+
+        // An alternating branch defeats a per-PC counter but is perfectly predictable
+        // from global history once the history register has been repaired and trained
+        uint32_t pc = 0x300;
+        int correct = 0;
+        for (int i = 0; i < 32; i++) {
+            bool ok = run_branch(pc, (i % 2) == 0, 0x400);
+            if (i >= 16 && ok) {
+                correct++;
+            }
+        }
+        CHECK(correct == 16);
+    }
+
+    void test_history_repair() {
+
+        // A mispredict restores the history the branch saw, plus its real outcome
+        dut->program_counter_fetch = 0x700;
+        eval();
+        uint32_t before = dut->prediction_history;
+        run_branch(0x700, true, 0x800);  // BTB miss: predicted not taken, actually taken
+        dut->program_counter_fetch = 0x704;
+        eval();
+        CHECK(dut->prediction_history == (((before << 1) | 1) & 0xFF));
+    }
+
+    void test_decode_repair() {
+
+        // A branch resolved in ID repairs the history the same way, one stage earlier
+        dut->program_counter_fetch = 0x900;
+        eval();
+        uint32_t before = dut->prediction_history;
+        dut->fetch_advance = 1;
+        tick();
+        dut->fetch_advance = 0;
+        dut->history_decode = before;
+        dut->is_branch_decode = 1;
+        dut->branch_taken_decode = 0;
+        dut->mispredict_decode = 1;
+        tick();
+        dut->mispredict_decode = 0;
+        eval();
+        CHECK(dut->prediction_history == ((before << 1) & 0xFF));
+
+        // A JAL redirected from ID restores its snapshot unchanged
+        dut->history_decode = 0x33;
+        dut->is_branch_decode = 0;
+        dut->mispredict_decode = 1;
+        tick();
+        dut->mispredict_decode = 0;
+        eval();
+        CHECK(dut->prediction_history == 0x33);
+
+        // An older EX redirect in the same cycle wins
+        dut->history_decode = 0x0F;
+        dut->branch_taken_decode = 1;
+        dut->mispredict_decode = 1;
+        dut->program_counter_execute = 0x904;
+        dut->branch_taken_execute = 0;
+        dut->is_branch_execute = 1;
+        dut->history_execute = 0xAA;
+        dut->is_branch_decode = 1;
+        dut->mispredict_execute = 1;
+        tick();
+        dut->mispredict_decode = 0;
+        dut->is_branch_execute = 0;
+        dut->mispredict_execute = 0;
+        eval();
+        CHECK(dut->prediction_history == 0x54);
+    }
+
+    void test_flush_restore() {
+
+        // A branch leaving EX updates the committed history with its outcome
+        dut->program_counter_execute = 0xA00;
+        dut->branch_taken_execute = 1;
+        dut->branch_target_execute = 0xB00;
+        dut->is_branch_execute = 1;
+        dut->history_execute = 0x15;
+        dut->execute_advance = 1;
+        tick();
+        dut->is_branch_execute = 0;
+        dut->execute_advance = 0;
+
+        // Younger fetches move the speculative history on
+        dut->history_decode = 0x77;
+        dut->is_branch_decode = 0;
+        dut->mispredict_decode = 1;
+        tick();
+        dut->mispredict_decode = 0;
+        eval();
+        CHECK(dut->prediction_history == 0x77);
+
+        // A backend flush (trap, MRET, interrupt, thread switch) restarts from the committed history
+        dut->restore = 1;
+        tick();
+        dut->restore = 0;
+        eval();
+        CHECK(dut->prediction_history == 0x2B);
+
+        // A branch leaving EX in the flush cycle is included, and an ID redirect is ignored
+        dut->history_execute = 0x2B;
+        dut->branch_taken_execute = 0;
+        dut->is_branch_execute = 1;
+        dut->execute_advance = 1;
+        dut->history_decode = 0x11;
+        dut->mispredict_decode = 1;
+        dut->restore = 1;
+        tick();
+        dut->is_branch_execute = 0;
+        dut->execute_advance = 0;
+        dut->mispredict_decode = 0;
+        dut->restore = 0;
+        eval();
+        CHECK(dut->prediction_history == 0x56);
+    }
+
+    void test_cold_branch_restore() {
+
+        // A cold branch (BTB miss) shifts its static prediction into the history at fetch,
+        // exactly as the committed history appends it when it leaves EX
+        dut->program_counter_fetch = 0x2000;
+        dut->instruction_fetch = BEQ_FWD_16;
+        eval();
+        uint32_t before = dut->prediction_history;
+        CHECK(dut->prediction_taken == 0);
+        dut->fetch_advance = 1;
+        tick();
+        dut->fetch_advance = 0;
+        dut->instruction_fetch = ADDI_NOP;
+        dut->program_counter_fetch = 0x2004;
+        eval();
+        uint32_t fetched = (before << 1) & 0xFF;
+        CHECK(dut->prediction_history == fetched);
+
+        // Resolved correctly: no repair, and a flush right after finds the same history
+        dut->program_counter_execute = 0x2000;
+        dut->branch_taken_execute = 0;
+        dut->branch_target_execute = 0x2010;
+        dut->is_branch_execute = 1;
+        dut->history_execute = before;
+        dut->execute_advance = 1;
+        tick();
+        dut->is_branch_execute = 0;
+        dut->execute_advance = 0;
+        dut->restore = 1;
+        tick();
+        dut->restore = 0;
+        eval();
+        CHECK(dut->prediction_history == fetched);
+
+        // A cold backward branch is predicted taken, then mispredicts in EX
+        dut->program_counter_fetch = 0x2100;
+        dut->instruction_fetch = BEQ_BACK_16;
+        eval();
+        CHECK(dut->prediction_taken == 1);
+        dut->fetch_advance = 1;
+        tick();
+        dut->fetch_advance = 0;
+        dut->instruction_fetch = ADDI_NOP;
+        eval();
+        CHECK(dut->prediction_history == (((fetched << 1) | 1) & 0xFF));
+
+        dut->program_counter_execute = 0x2100;
+        dut->branch_taken_execute = 0;
+        dut->branch_target_execute = 0x20F0;
+        dut->is_branch_execute = 1;
+        dut->history_execute = fetched;
+        dut->mispredict_execute = 1;
+        dut->execute_advance = 1;
+        tick();
+        dut->is_branch_execute = 0;
+        dut->mispredict_execute = 0;
+        dut->execute_advance = 0;
+        eval();
+        uint32_t repaired = (fetched << 1) & 0xFF;
+        CHECK(dut->prediction_history == repaired);
+
+        // A later flush restores the committed history, which agrees with the repair
+        dut->restore = 1;
+        tick();
+        dut->restore = 0;
+        eval();
+        CHECK(dut->prediction_history == repaired);
+    }
+
+    void test_static_prediction() {
+
+        // BTB miss: backward branches are predicted taken to their own target, forward ones not taken
+        dut->instruction_fetch = BEQ_BACK_16;
+        check_prediction(0x1000, true, 0x0FF0, "Cold backward branch");
+        dut->instruction_fetch = BEQ_FWD_16;
+        check_prediction(0x1000, false, 0, "Cold forward branch");
+
+        // Once the branch is in the BTB its counter decides
+        train_branch(0x1000, false, 0x0FF0);
+        dut->instruction_fetch = BEQ_BACK_16;
+        check_prediction(0x1000, false, 0, "Warm backward branch, counter not taken");
+        dut->instruction_fetch = ADDI_NOP;
+        eval();
+    }
 };
 
 TEST_CASE("Branch Predictor") {
@@ -141,4 +386,16 @@ BranchPredictorTestbench tb;
         tb.test_training_to_not_taken();
         tb.test_multiple_branches();
         tb.test_jump_updates();
+        tb.test_static_prediction();
+}
+
+TEST_CASE("Branch Predictor Global History") {
+BranchPredictorTestbench tb;
+
+        tb.reset();
+        tb.test_global_history();
+        tb.test_history_repair();
+        tb.test_decode_repair();
+        tb.test_flush_restore();
+        tb.test_cold_branch_restore();
 }
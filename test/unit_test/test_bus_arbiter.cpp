@@ -17,6 +17,10 @@ public:
         dut->m1_addr = 0;
         dut->m1_wdata = 0;
         dut->m1_write = 0;
+        dut->m0_burst = 0;
+        dut->m1_burst = 0;
+        dut->m0_abort = 0;
+        dut->m1_abort = 0;
     }
     
     void set_clk(uint8_t value) override {
@@ -117,6 +121,130 @@ public:
         dut->bus_ready = 0;
         tick();
     }
+
+    void test_burst_lock() {
+
+        // M1 starts a line-fill burst
+        dut->m1_enable = 1;
+        dut->m1_addr = 0x6000;
+        dut->m1_burst = 1;
+        dut->bus_ready = 0;
+        eval();
+        CHECK(dut->bus_addr == 0x6000);
+        CHECK(dut->bus_burst == 1);
+        tick();
+
+        // M0 arrives mid-burst; M1 keeps the bus for all 4 beats
+        dut->m0_enable = 1;
+        dut->m0_addr = 0x5000;
+        for (int beat = 0; beat < 4; beat++) {
+            INFO("beat " << beat);
+            dut->bus_ready = 1;
+            eval();
+            CHECK(dut->bus_addr == 0x6000);
+            CHECK(dut->m1_ready == 1);
+            CHECK(dut->m0_ready == 0);
+            tick();
+        }
+
+        // Released after the last beat
+        dut->m1_enable = 0;
+        dut->m1_burst = 0;
+        dut->bus_ready = 0;
+        eval();
+        CHECK(dut->bus_addr == 0x5000);
+        CHECK(dut->bus_burst == 0);
+
+        // Cleanup
+        dut->m0_enable = 0;
+        tick();
+    }
+
+    void test_grant_same_address() {
+
+        // Both masters request the same line: the grant, not the address, tells them apart
+        dut->m0_enable = 1;
+        dut->m0_addr = 0x7000;
+        dut->m1_enable = 1;
+        dut->m1_addr = 0x7000;
+        dut->bus_ready = 0;
+        eval();
+        int first = dut->m0_grant ? 0 : 1;
+        CHECK(dut->m0_grant + dut->m1_grant == 1);
+        CHECK(dut->bus_addr == 0x7000);
+        tick();
+
+        // The grant holds while the owner waits
+        eval();
+        CHECK((first == 0 ? dut->m0_grant : dut->m1_grant) == 1);
+
+        // After the transfer the other master gets the bus
+        dut->bus_ready = 1;
+        eval();
+        tick();
+        dut->bus_ready = 0;
+        eval();
+        CHECK((first == 0 ? dut->m1_grant : dut->m0_grant) == 1);
+        CHECK((first == 0 ? dut->m0_grant : dut->m1_grant) == 0);
+
+        // Both release: no grant once the owner is dropped
+        dut->m0_enable = 0;
+        dut->m1_enable = 0;
+        tick();
+        eval();
+        CHECK(dut->m0_grant == 0);
+        CHECK(dut->m1_grant == 0);
+    }
+
+    void test_burst_abort() {
+
+        // M1 starts a burst and takes two beats
+        dut->m1_enable = 1;
+        dut->m1_addr = 0x6010;
+        dut->m1_burst = 1;
+        dut->bus_ready = 0;
+        tick();
+        dut->m0_enable = 1;
+        dut->m0_addr = 0x5000;
+        for (int beat = 0; beat < 2; beat++) {
+            dut->bus_ready = 1;
+            eval();
+            CHECK(dut->m1_ready == 1);
+            tick();
+        }
+
+        // M1 aborts it and starts a new burst in the same cycle: it keeps the bus, and the
+        // beat count starts over
+        dut->bus_ready = 0;
+        dut->m1_abort = 1;
+        dut->m1_addr = 0x6100;
+        eval();
+        CHECK(dut->bus_abort == 1);
+        CHECK(dut->bus_addr == 0x6100);
+        CHECK(dut->m1_grant == 1);
+        tick();
+        dut->m1_abort = 0;
+        for (int beat = 0; beat < 4; beat++) {
+            INFO("beat " << beat);
+            dut->bus_ready = 1;
+            eval();
+            CHECK(dut->bus_abort == 0);
+            CHECK(dut->bus_addr == 0x6100);
+            CHECK(dut->m1_ready == 1);
+            tick();
+        }
+
+        // Released after the new burst's last beat
+        dut->m1_enable = 0;
+        dut->m1_burst = 0;
+        dut->bus_ready = 0;
+        eval();
+        CHECK(dut->bus_addr == 0x5000);
+
+        // Cleanup
+        dut->m0_enable = 0;
+        tick();
+    }
 };
 
 TEST_CASE("Bus Arbiter") {
@@ -126,4 +254,7 @@ BusArbiterTestbench tb;
         tb.test_m0_request();
         tb.test_m1_request();
         tb.test_concurrent_requests();
+        tb.test_burst_lock();
+        tb.test_grant_same_address();
+        tb.test_burst_abort();
 }
@@ -11,6 +11,19 @@
 #define CSR_MCAUSE   0x342
 #define CSR_MIP      0x344
 #define CSR_MHARTID  0xF14
+#define CSR_MCOUNTINHIBIT 0x320
+#define CSR_MHPMEVENT3    0x323
+#define CSR_MCYCLE        0xB00
+#define CSR_MINSTRET      0xB02
+#define CSR_MHPMCOUNTER3  0xB03
+#define CSR_MCYCLEH       0xB80
+#define CSR_CYCLE         0xC00
+#define CSR_INSTRET       0xC02
+#define CSR_HPMCOUNTER3   0xC03
+
+#ifndef CSR_THREADS
+#define CSR_THREADS 1
+#endif
 
 /**
  * CSR File Testbench
@@ -29,6 +42,9 @@ public:
         dut->machine_return_enable = 0;
         dut->timer_interrupt_request = 0;
         dut->hart_id = 0;
+        dut->thread = 0;
+        dut->retire_count = 0;
+        dut->performance_events = 0;
     }
     
     void set_clk(uint8_t value) override {
@@ -115,6 +131,14 @@ public:
         mip = read_csr(CSR_MIP);
         CHECK(((mip >> 7) & 1) == 1);
         
+        // Pending only counts when enabled in mie; it wakes WFI even with mstatus.MIE off (no trap)
+        write_csr(CSR_MIE, 0);
+        CHECK(dut->interrupt_pending == 0);
+        write_csr(CSR_MIE, 1 << 7);
+        CHECK(dut->interrupt_pending == 1);
+        CHECK(dut->interrupt_enable == 0);
+        write_csr(CSR_MIE, 0x888);
+        
         dut->timer_interrupt_request = 0;
     }
     
@@ -131,6 +155,101 @@ public:
         // MEPC output should be available
         CHECK(dut->mepc_out == 0x1234);
     }
+
+    void test_counters() {
+
+        // mcycle counts every cycle; cycle is its read-only user copy
+        uint32_t start = read_csr(CSR_MCYCLE);
+        tick(10);
+        CHECK(read_csr(CSR_MCYCLE) - start == 10);
+        CHECK(read_csr(CSR_CYCLE) == read_csr(CSR_MCYCLE));
+
+        // minstret adds the instructions retired each cycle (two with dual issue)
+        start = read_csr(CSR_MINSTRET);
+        dut->retire_count = 2;
+        tick(3);
+        dut->retire_count = 0;
+        CHECK(read_csr(CSR_MINSTRET) - start == 6);
+        CHECK(read_csr(CSR_INSTRET) == read_csr(CSR_MINSTRET));
+
+        // mcountinhibit freezes CY and IR
+        write_csr(CSR_MCOUNTINHIBIT, 0x5);
+        uint32_t cycle = read_csr(CSR_MCYCLE);
+        uint32_t instret = read_csr(CSR_MINSTRET);
+        dut->retire_count = 1;
+        tick(5);
+        dut->retire_count = 0;
+        CHECK(read_csr(CSR_MCYCLE) == cycle);
+        CHECK(read_csr(CSR_MINSTRET) == instret);
+        CHECK(read_csr(CSR_MCOUNTINHIBIT) == 0x5);
+
+        // 64-bit counter: a write wins over the increment, the carry reaches the high half
+        write_csr(CSR_MCYCLEH, 0x12);
+        write_csr(CSR_MCYCLE, 0xFFFFFFFF);
+        write_csr(CSR_MCOUNTINHIBIT, 0);
+        tick();
+        CHECK(read_csr(CSR_MCYCLE) == 0);
+        CHECK(read_csr(CSR_MCYCLEH) == 0x13);
+    }
+
+    void test_hpm_counters() {
+
+        // mhpmcounter3 counts D-Cache misses (event 2), mhpmcounter4 bus-wait cycles (event 7)
+        write_csr(CSR_MHPMEVENT3, 2);
+        write_csr(CSR_MHPMEVENT3 + 1, 7);
+        CHECK(read_csr(CSR_MHPMEVENT3) == 2);
+
+        dut->performance_events = 1 << 2;
+        tick(4);
+        dut->performance_events = (1 << 2) | (1 << 7);
+        tick();
+        dut->performance_events = 0;
+        CHECK(read_csr(CSR_MHPMCOUNTER3) == 5);
+        CHECK(read_csr(CSR_MHPMCOUNTER3 + 1) == 1);
+        CHECK(read_csr(CSR_HPMCOUNTER3) == 5);
+        CHECK(read_csr(CSR_MHPMCOUNTER3 + 2) == 0); // Event 0 counts nothing
+
+        // Inhibit bit 3 freezes mhpmcounter3 only
+        write_csr(CSR_MCOUNTINHIBIT, 1 << 3);
+        dut->performance_events = (1 << 2) | (1 << 7);
+        tick(3);
+        dut->performance_events = 0;
+        CHECK(read_csr(CSR_MHPMCOUNTER3) == 5);
+        CHECK(read_csr(CSR_MHPMCOUNTER3 + 1) == 4);
+        write_csr(CSR_MCOUNTINHIBIT, 0);
+
+        // The last programmable counter is there too
+        write_csr(CSR_MHPMCOUNTER3 + 7, 0x77);
+        CHECK(read_csr(CSR_HPMCOUNTER3 + 7) == 0x77);
+    }
+
+    // Each hardware context has its own trap state and hart ID
+    void test_thread_contexts() {
+
+        dut->hart_id = 4;
+        dut->thread = 1;
+        CHECK(read_csr(CSR_MHARTID) == 5);
+        CHECK(read_csr(CSR_MTVEC) == 0); // Written by context 0 only
+        CHECK(read_csr(CSR_MEPC) == 0);
+
+        write_csr(CSR_MTVEC, 0x3000);
+        dut->exception_enable = 1;
+        dut->exception_program_counter = 0x600;
+        dut->exception_cause = 0xB;
+        tick();
+        dut->exception_enable = 0;
+        CHECK(read_csr(CSR_MEPC) == 0x600);
+        CHECK(read_csr(CSR_MCAUSE) == 0xB);
+        CHECK(dut->mtvec_out == 0x3000);
+
+        // Context 0 is untouched
+        dut->thread = 0;
+        CHECK(read_csr(CSR_MHARTID) == 4);
+        CHECK(read_csr(CSR_MTVEC) == 0x2000);
+        CHECK(read_csr(CSR_MEPC) == 0x1234);
+        CHECK(read_csr(CSR_MCAUSE) == 0x8);
+        dut->hart_id = 0;
+    }
 };
 
 TEST_CASE("Control Status Register File") {
@@ -142,4 +261,9 @@ CSRTestbench tb;
         tb.test_exception_handling();
         tb.test_interrupt_pending();
         tb.test_mret();
+        tb.test_counters();
+        tb.test_hpm_counters();
+#if CSR_THREADS > 1
+        tb.test_thread_contexts();
+#endif
 }
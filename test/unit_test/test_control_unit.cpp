@@ -34,6 +34,9 @@ public:
             else if (sig.first == "alu_source_a_select") got = dut->alu_source_a_select;
             else if (sig.first == "csr_write_enable") got = dut->csr_write_enable;
             else if (sig.first == "csr_to_register_select") got = dut->csr_to_register_select;
+            else if (sig.first == "is_environment_call") got = dut->is_environment_call;
+            else if (sig.first == "is_machine_return") got = dut->is_machine_return;
+            else if (sig.first == "is_wait_for_interrupt") got = dut->is_wait_for_interrupt;
             
             CHECK(got == sig.second);
         }
@@ -127,6 +130,39 @@ public:
             {"csr_to_register_select", 1}
         }, "CSRRW");
     }
+    
+    void test_system() {
+        // ECALL, MRET and WFI share funct3 = 0 and differ in funct7/rs2
+        dut->function_7 = 0b0000000;
+        dut->rs2_index = 0b00000;
+        check(0b1110011, 0b000, 0, {
+            {"is_environment_call", 1},
+            {"is_machine_return", 0},
+            {"is_wait_for_interrupt", 0},
+            {"register_write_enable", 0}
+        }, "ECALL");
+        
+        dut->function_7 = 0b0011000;
+        dut->rs2_index = 0b00010;
+        check(0b1110011, 0b000, 0, {
+            {"is_environment_call", 0},
+            {"is_machine_return", 1},
+            {"is_wait_for_interrupt", 0}
+        }, "MRET");
+        
+        dut->function_7 = 0b0001000;
+        dut->rs2_index = 0b00101;
+        check(0b1110011, 0b000, 0, {
+            {"is_environment_call", 0},
+            {"is_machine_return", 0},
+            {"is_wait_for_interrupt", 1},
+            {"register_write_enable", 0},
+            {"csr_write_enable", 0}
+        }, "WFI");
+        
+        dut->function_7 = 0;
+        dut->rs2_index = 0;
+    }
 };
 
 TEST_CASE("Control Unit") {
@@ -142,4 +178,5 @@ ControlUnitTestbench tb;
         tb.test_lui();
         tb.test_auipc();
         tb.test_csr();
+        tb.test_system();
 }
@@ -15,6 +15,8 @@ private:
     // Simulated memory
     std::unordered_map<uint32_t, uint32_t> memory;
     uint64_t cycle_count;
+    int burst_beat = 0;
+    bool burst_addressed = false;
     
 public:
     CoreTileTestbench() : ClockedTestbench<Vcore_tile>(100, false), cycle_count(0) {
@@ -24,6 +26,7 @@ public:
         dut->bus_ready = 0;
         dut->bus_rdata = 0;
         dut->timer_irq = 0;
+        dut->l2_miss = 0;
         
     }
     
@@ -45,8 +48,25 @@ public:
     
     // Handle bus transactions (simulate memory)
     void handle_bus() {
+        if (dut->bus_abort) {
+            // The burst in flight ends early; a request that comes with the abort starts over
+            burst_beat = 0;
+            burst_addressed = false;
+        }
         if (dut->bus_req) {
             uint32_t addr = dut->bus_addr & 0xFFFFFFFC;  // Word-aligned
+
+            // Line-fill burst: address phase first, then one beat per cycle wrapping within the line
+            if (dut->bus_burst) {
+                if (!burst_addressed) {
+                    burst_addressed = true;
+                    dut->bus_ready = 0;
+                    return;
+                }
+                addr = (addr & ~0xFu) | ((addr + burst_beat * 4) & 0xFu);
+                burst_beat = (burst_beat + 1) % 4;
+                burst_addressed = (burst_beat != 0);
+            }
             
             if (dut->bus_we) {
                 // Write operation
@@ -76,6 +96,8 @@ public:
             }
         } else {
             dut->bus_ready = 0;
+            burst_beat = 0;
+            burst_addressed = false;
         }
     }
     
@@ -0,0 +1,215 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "tb_base.h"
+#include "Vfetch_queue.h"
+#include "Vfetch_queue___024root.h"
+#include <string>
+
+static constexpr int DEPTH = 4;
+
+/**
+ * Fetch Queue Testbench
+ * The frontend pushes fetched instructions at the tail, the backend decodes
+ * the head and pops it when ID advances. Entries carry the prediction
+ * metadata; a flush drops everything.
+ */
+class FetchQueueTestbench : public ClockedTestbench<Vfetch_queue> {
+public:
+    FetchQueueTestbench() : ClockedTestbench<Vfetch_queue>(100, false) {
+        dut->rst_n = 0;
+        dut->push = 0;
+        dut->push_program_counter = 0;
+        dut->push_instruction = 0;
+        dut->push_prediction_taken = 0;
+        dut->push_prediction_target = 0;
+        dut->push_prediction_history = 0;
+        dut->pop = 0;
+        dut->flush = 0;
+        dut->push_second = 0;
+        dut->push_second_program_counter = 0;
+        dut->push_second_instruction = 0;
+        dut->pop_second = 0;
+    }
+
+    void set_clk(uint8_t value) override {
+        dut->clk = value;
+    }
+
+    void reset() {
+        dut->rst_n = 0;
+        tick();
+        dut->rst_n = 1;
+        tick();
+    }
+
+    // One cycle: optionally push the instruction at pc (instruction = pc | 0x13), optionally pop.
+    // Returns whether the push was accepted.
+    bool cycle(bool push, uint32_t pc, bool pop) {
+        dut->push = push ? 1 : 0;
+        dut->push_program_counter = pc;
+        dut->push_instruction = pc | 0x13;
+        dut->push_prediction_taken = (pc >> 2) & 1;
+        dut->push_prediction_target = pc + 0x100;
+        dut->push_prediction_history = pc >> 2;
+        dut->pop = pop ? 1 : 0;
+        eval();
+        bool accepted = push && dut->push_ready;
+        tick();
+        dut->push = 0;
+        dut->pop = 0;
+        eval();
+        return accepted;
+    }
+
+    void check_head(uint32_t pc, const char* name) {
+        eval();
+        INFO(name);
+        CHECK(dut->empty == 0);
+        CHECK(dut->head_program_counter == pc);
+        CHECK(dut->head_instruction == (pc | 0x13));
+        CHECK(dut->head_prediction_taken == ((pc >> 2) & 1));
+        CHECK(dut->head_prediction_target == pc + 0x100);
+        CHECK(dut->head_prediction_history == (pc >> 2));
+    }
+
+    void check_empty(const char* name) {
+        eval();
+        INFO(name);
+        CHECK(dut->empty == 1);
+        CHECK(dut->head_instruction == 0);  // Bubble
+        CHECK(dut->head_prediction_taken == 0);
+    }
+
+    void test_empty() {
+
+        // Nothing fetched yet: ID sees a bubble
+        check_empty("After reset");
+        CHECK(dut->push_ready == 1);
+    }
+
+    void test_fill_while_backend_stalls() {
+
+        // The backend is stalled: the frontend fetches ahead until the queue is full
+        for (int i = 0; i < DEPTH; i++) {
+            CHECK(cycle(true, 0x100 + i * 4, false));
+        }
+        check_head(0x100, "Oldest entry at the head");
+        CHECK(dut->push_ready == 0);
+        CHECK_FALSE(cycle(true, 0x110, false));
+
+        // Full, but the head leaves this cycle: the push is accepted
+        CHECK(cycle(true, 0x110, true));
+        check_head(0x104, "Head advanced");
+
+        // Drain in order
+        for (int i = 1; i <= DEPTH; i++) {
+            check_head(0x100 + i * 4, "Drain");
+            cycle(false, 0, true);
+        }
+        check_empty("Drained");
+    }
+
+    void test_fetch_stall_absorbed() {
+
+        // Entries fetched ahead keep ID busy while the frontend is stalled (no pushes)
+        cycle(true, 0x200, false);
+        cycle(true, 0x204, false);
+        cycle(true, 0x208, false);
+        int decoded = 0;
+        for (int i = 0; i < 3; i++) {
+            eval();
+            if (!dut->empty) decoded++;
+            cycle(false, 0, true);
+        }
+        CHECK(decoded == 3);
+
+        // Push and pop in the same cycle on an empty queue: the push stays
+        cycle(true, 0x20C, true);
+        check_head(0x20C, "Pushed while empty");
+        cycle(false, 0, true);
+        check_empty("Popped");
+        CHECK(dut->rootp->fetch_queue__DOT__empty_cycles >= 1);
+    }
+
+    void test_flush() {
+
+        cycle(true, 0x300, false);
+        cycle(true, 0x304, false);
+
+        // A flush drops every entry, including a push in the same cycle
+        dut->flush = 1;
+        cycle(true, 0x308, false);
+        dut->flush = 0;
+        check_empty("After flush");
+
+        // Wraparound after the flush keeps FIFO order
+        for (int i = 0; i < DEPTH + 2; i++) {
+            cycle(true, 0x400 + i * 4, i >= 2);
+        }
+        check_head(0x410, "FIFO order across the wrap");
+        for (int i = 0; i < DEPTH; i++) cycle(false, 0, true);
+        check_empty("Drained after the wrap");
+    }
+
+    // Dual issue: push pc and pc + 4 together, optionally pop one or two.
+    // Returns whether the second push was accepted.
+    bool cycle_pair(uint32_t pc, bool pop, bool pop_second) {
+        dut->push_second = 1;
+        dut->push_second_program_counter = pc + 4;
+        dut->push_second_instruction = (pc + 4) | 0x13;
+        dut->pop = pop ? 1 : 0;
+        dut->pop_second = pop_second ? 1 : 0;
+        eval();
+        bool accepted = dut->push_second_ready;
+        cycle(true, pc, pop);
+        dut->push_second = 0;
+        dut->pop_second = 0;
+        eval();
+        return accepted;
+    }
+
+    void test_pairs() {
+
+        // Two entries per cycle
+        CHECK(cycle_pair(0x500, false, false));
+        CHECK(dut->second_valid == 1);
+        check_head(0x500, "First of the pair at the head");
+        CHECK(dut->second_program_counter == 0x504);
+        CHECK(dut->second_instruction == (0x504 | 0x13));
+        CHECK(dut->second_prediction_taken == 0);
+
+        // Full after a second pair; one free entry is not enough for a pair
+        CHECK(cycle_pair(0x508, false, false));
+        CHECK(dut->push_ready == 0);
+        cycle(false, 0, true);
+        eval();
+        CHECK(dut->push_ready == 1);
+        CHECK(dut->push_second_ready == 0);
+
+        // Popping two makes room for a pair in the same cycle, across the wrap
+        CHECK(cycle_pair(0x510, true, true));
+        check_head(0x50C, "Two popped, two pushed");
+        CHECK(dut->second_program_counter == 0x510);
+
+        // pop_second without a second entry pops only the head
+        cycle(false, 0, true);
+        cycle(false, 0, true);
+        check_head(0x514, "Last entry");
+        CHECK(dut->second_valid == 0);
+        dut->pop_second = 1;
+        cycle(false, 0, true);
+        dut->pop_second = 0;
+        check_empty("Drained");
+    }
+};
+
+TEST_CASE("Fetch Queue") {
+FetchQueueTestbench tb;
+
+        tb.reset();
+        tb.test_empty();
+        tb.test_fill_while_backend_stalls();
+        tb.test_fetch_stall_absorbed();
+        tb.test_flush();
+        tb.test_pairs();
+}
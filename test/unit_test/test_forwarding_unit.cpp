@@ -11,6 +11,10 @@
 class ForwardingTestbench : public TestbenchBase<Vforwarding_unit> {
 public:
     ForwardingTestbench() : TestbenchBase<Vforwarding_unit>(false) {
+        dut->rd_index_memory_second = 0;
+        dut->register_write_enable_memory_second = 0;
+        dut->rd_index_writeback_second = 0;
+        dut->register_write_enable_writeback_second = 0;
     }
     
     void check(uint8_t rs1_ex, uint8_t rs2_ex, uint8_t rd_mem, uint8_t we_mem,
@@ -53,6 +57,34 @@ public:
         check(0, 2, 0, 1, 4, 0, 0b00, 0b00, "x0 Forwarding A");
         check(1, 0, 0, 1, 4, 0, 0b00, 0b00, "x0 Forwarding B");
     }
+
+    // Second pipe (dual issue) producers in MEM and WB
+    void check_second(uint8_t rd_mem_second, uint8_t we_mem_second, uint8_t rd_wb_second, uint8_t we_wb_second,
+                      uint8_t rd_mem, uint8_t we_mem, uint8_t rd_wb, uint8_t we_wb,
+                      uint8_t exp_a, uint8_t exp_b, const char* name) {
+        dut->rd_index_memory_second = rd_mem_second;
+        dut->register_write_enable_memory_second = we_mem_second;
+        dut->rd_index_writeback_second = rd_wb_second;
+        dut->register_write_enable_writeback_second = we_wb_second;
+        check(1, 2, rd_mem, we_mem, rd_wb, we_wb, exp_a, exp_b, name);
+        dut->register_write_enable_memory_second = 0;
+        dut->register_write_enable_writeback_second = 0;
+    }
+
+    void test_second_pipe() {
+        check_second(1, 1, 0, 0, 3, 0, 4, 0, 0b011, 0b000, "Second pipe MEM A");
+        check_second(0, 0, 2, 1, 3, 0, 4, 0, 0b000, 0b100, "Second pipe WB B");
+
+        // Same stage: the second pipe's instruction is the younger one
+        check_second(1, 1, 0, 0, 1, 1, 4, 0, 0b011, 0b000, "MEM second before MEM first");
+        check_second(0, 0, 2, 1, 3, 0, 2, 1, 0b000, 0b100, "WB second before WB first");
+
+        // Across stages: MEM is always younger than WB
+        check_second(0, 0, 1, 1, 1, 1, 4, 0, 0b010, 0b000, "MEM first before WB second");
+        check_second(2, 1, 0, 0, 3, 0, 2, 1, 0b000, 0b011, "MEM second before WB first");
+
+        check_second(0, 1, 0, 1, 3, 0, 4, 0, 0b000, 0b000, "Writes to x0 never forwarded");
+    }
 };
 
 TEST_CASE("Forwarding Unit") {
@@ -63,4 +95,5 @@ ForwardingTestbench tb;
         tb.test_mem_hazard();
         tb.test_priority();
         tb.test_x0_never_forward();
+        tb.test_second_pipe();
 }
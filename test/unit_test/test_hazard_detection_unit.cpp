@@ -5,11 +5,18 @@
 
 /**
  * Hazard Detection Unit Testbench
- * Detects load-use hazards that require pipeline stall
+ * Detects load-use hazards and scoreboard (pending MDU result) hazards that require pipeline stall
  */
 class HazardDetectionTestbench : public TestbenchBase<Vhazard_detection_unit> {
 public:
     HazardDetectionTestbench() : TestbenchBase<Vhazard_detection_unit>(false) {
+        dut->rd_index_decode = 0;
+        dut->register_write_enable_decode = 0;
+        dut->pending_registers = 0;
+        dut->rs1_index_second = 0;
+        dut->rs2_index_second = 0;
+        dut->rd_index_second = 0;
+        dut->register_write_enable_second = 0;
     }
     
     void check(uint8_t rs1_id, uint8_t rs2_id, uint8_t rd_ex, uint8_t mem_read_ex, uint8_t expected_stall, const char* name) {
@@ -21,6 +28,7 @@ public:
         
         INFO(name);
         CHECK(dut->stall_pipeline == expected_stall);
+        CHECK(dut->stall_load_use == (expected_stall && mem_read_ex)); // Scoreboard stalls are not load-use
     }
     
     void test_no_hazard() {
@@ -34,11 +42,65 @@ public:
         check(1, 1, 1, 1, 1, "Hazard on both RS1==RS2");
     }
     
+    // Scoreboard: ID instruction (rs1, rs2, rd) against registers waiting for an MDU result
+    void check_pending(uint8_t rs1_id, uint8_t rs2_id, uint8_t rd_id, uint8_t write_id, uint32_t pending, uint8_t expected_stall, const char* name) {
+        dut->rd_index_decode = rd_id;
+        dut->register_write_enable_decode = write_id;
+        dut->pending_registers = pending;
+        check(rs1_id, rs2_id, 0, 0, expected_stall, name);
+        dut->register_write_enable_decode = 0;
+        dut->pending_registers = 0;
+    }
+
+    void test_scoreboard_hazard() {
+        check_pending(1, 2, 3, 1, 0, 0, "Nothing pending");
+        check_pending(1, 2, 3, 1, 1u << 5, 0, "Unrelated register pending");
+        check_pending(5, 2, 3, 1, 1u << 5, 1, "RAW on RS1");
+        check_pending(1, 5, 3, 1, 1u << 5, 1, "RAW on RS2");
+        check_pending(1, 2, 5, 1, 1u << 5, 1, "WAW on RD");
+        check_pending(1, 2, 5, 0, 1u << 5, 0, "RD field of a non-writing instruction");
+    }
+    
     void test_x0_no_stall() {
         check(0, 2, 0, 1, 0, "x0 Hazard Check RS1");
         check(1, 0, 0, 1, 0, "x0 Hazard Check RS2");
         check(0, 0, 0, 1, 0, "x0 Hazard Check Both");
     }
+
+    // Pairing: the second instruction (rs1, rs2, rd) against the first (rd), a load in EX and the scoreboard
+    void check_second(uint8_t rd_first, uint8_t rs1_second, uint8_t rs2_second, uint8_t rd_second,
+                      uint8_t rd_ex, uint8_t mem_read_ex, uint32_t pending, uint8_t expected, const char* name) {
+        dut->rs1_index_decode = 0;
+        dut->rs2_index_decode = 0;
+        dut->rd_index_decode = rd_first;
+        dut->register_write_enable_decode = 1;
+        dut->rd_index_execute = rd_ex;
+        dut->memory_read_enable_execute = mem_read_ex;
+        dut->pending_registers = pending;
+        dut->rs1_index_second = rs1_second;
+        dut->rs2_index_second = rs2_second;
+        dut->rd_index_second = rd_second;
+        dut->register_write_enable_second = 1;
+        eval();
+
+        INFO(name);
+        CHECK(dut->stall_second == expected);
+        dut->register_write_enable_decode = 0;
+        dut->register_write_enable_second = 0;
+        dut->pending_registers = 0;
+    }
+
+    void test_pairing_hazard() {
+        check_second(1, 2, 3, 4, 0, 0, 0, 0, "Independent pair");
+        check_second(1, 1, 3, 4, 0, 0, 0, 1, "Second reads the first's rd (RS1)");
+        check_second(1, 2, 1, 4, 0, 0, 0, 1, "Second reads the first's rd (RS2)");
+        check_second(1, 2, 3, 1, 0, 0, 0, 1, "Both write the same rd");
+        check_second(0, 0, 3, 0, 0, 0, 0, 0, "x0 is no dependency");
+        check_second(1, 5, 3, 4, 5, 1, 0, 1, "Second reads a load in EX");
+        check_second(1, 5, 3, 4, 5, 0, 0, 0, "Second reads an ALU result in EX (forwarded)");
+        check_second(1, 2, 6, 4, 0, 0, 1u << 6, 1, "Second reads a pending MDU result");
+        check_second(1, 2, 3, 6, 0, 0, 1u << 6, 1, "Second writes a pending register");
+    }
 };
 
 TEST_CASE("Hazard Detection Unit") {
@@ -47,4 +109,6 @@ HazardDetectionTestbench tb;
         tb.test_no_hazard();
         tb.test_load_use_hazard();
         tb.test_x0_no_stall();
+        tb.test_scoreboard_hazard();
+        tb.test_pairing_hazard();
 }
@@ -15,6 +15,11 @@ public:
         dut->dcache_wdata = 0;
         dut->dcache_we = 0;
         dut->dcache_be = 0;
+        dut->icache_burst = 0;
+        dut->icache_prefetch = 0;
+        dut->icache_abort = 0;
+        dut->dcache_burst = 0;
+        dut->dcache_abort = 0;
         dut->m_ready = 0;
         dut->m_rdata = 0;
     }
@@ -126,6 +131,254 @@ public:
         dut->m_ready = 0;
         tick();
     }
+
+    void test_icache_burst_holds_grant() {
+
+        // I-Cache line fill burst
+        dut->icache_addr = 0x5000;
+        dut->icache_req = 1;
+        dut->icache_burst = 1;
+        tick();  // Enter STATE_ICACHE
+        CHECK(dut->m_burst == 1);
+
+        // A D-Cache request arriving mid-burst waits for the last beat
+        dut->dcache_addr = 0x6000;
+        dut->dcache_req = 1;
+        for (int beat = 0; beat < 4; beat++) {
+            INFO("beat " << beat);
+            CHECK(dut->m_addr == 0x5000);
+            dut->m_ready = 1;
+            dut->m_rdata = 0xF00D0000 + beat;
+            eval();
+            CHECK(dut->icache_ready == 1);
+            CHECK(dut->icache_rdata == 0xF00D0000u + beat);
+            CHECK(dut->dcache_ready == 0);
+            tick();
+        }
+        dut->m_ready = 0;
+        dut->icache_req = 0;
+        dut->icache_burst = 0;
+        tick();  // Enter STATE_DCACHE
+
+        CHECK(dut->m_addr == 0x6000);
+        CHECK(dut->m_burst == 0);
+
+        // Cleanup
+        dut->m_ready = 1;
+        eval();
+        tick();
+        dut->dcache_req = 0;
+        dut->m_ready = 0;
+        tick();
+    }
+
+    void test_prefetch_yields_to_dcache() {
+
+        // D-Cache access
+        dut->dcache_addr = 0x7000;
+        dut->dcache_we = 0;
+        dut->dcache_req = 1;
+        tick();  // Enter STATE_DCACHE
+        dut->m_ready = 1;
+        eval();
+        CHECK(dut->dcache_ready == 1);
+        tick();  // Back to IDLE
+        dut->dcache_req = 0;
+        dut->m_ready = 0;
+
+        // A prefetch is held off for the cycle right after D-Cache activity
+        dut->icache_addr = 0x8010;
+        dut->icache_req = 1;
+        dut->icache_burst = 1;
+        dut->icache_prefetch = 1;
+        eval();
+        CHECK(dut->m_req == 0);
+        tick();
+
+        // ...and granted once the D-Cache stays quiet
+        eval();
+        CHECK(dut->m_req == 1);
+        CHECK(dut->m_addr == 0x8010);
+        tick();  // Enter STATE_ICACHE
+        for (int beat = 0; beat < 4; beat++) {
+            dut->m_ready = 1;
+            eval();
+            CHECK(dut->icache_ready == 1);
+            tick();
+        }
+
+        // Cleanup
+        dut->m_ready = 0;
+        dut->icache_req = 0;
+        dut->icache_burst = 0;
+        dut->icache_prefetch = 0;
+        tick();
+    }
+
+    // Memory model for the latency test: an address cycle, then one beat per cycle. An abort
+    // or a dropped request ends the burst; a request that comes with an abort has its
+    // address cycle right there, as from an idle port.
+    int mem_beat = -1; // -1: address cycle
+
+    void mem_eval() {
+        dut->m_ready = 0;
+        eval();
+        if (dut->m_abort || !dut->m_req) mem_beat = -1;
+        if (dut->m_req && mem_beat >= 0) {
+            dut->m_ready = 1;
+            dut->m_rdata = dut->m_addr + mem_beat * 4;
+            eval();
+        }
+    }
+
+    void mem_tick() {
+        if (dut->m_req) {
+            if (mem_beat < 0) mem_beat = 0;
+            else if (dut->m_burst && mem_beat < 3) mem_beat++;
+            else mem_beat = -1;
+        }
+        tick();
+    }
+
+    // Cycles from a D-Cache line-fill request to its last beat. A prefetch in flight is
+    // dropped by the I-Cache the cycle after it is preempted.
+    int dcache_burst_latency(int& preempted) {
+        dut->dcache_addr = 0xA000;
+        dut->dcache_we = 0;
+        dut->dcache_burst = 1;
+        dut->dcache_req = 1;
+        int beats = 0;
+        int cycles = 0;
+        while (beats < 4 && cycles < 20) {
+            mem_eval();
+            CHECK(dut->icache_ready == 0);
+            bool drop = dut->icache_preempted;
+            preempted += drop;
+            beats += dut->dcache_ready;
+            cycles++;
+            mem_tick();
+            if (drop) {
+                dut->icache_req = 0;
+                dut->icache_burst = 0;
+                dut->icache_prefetch = 0;
+            }
+        }
+        dut->dcache_req = 0;
+        dut->dcache_burst = 0;
+        mem_eval();
+        mem_tick();
+        return cycles;
+    }
+
+    void test_dcache_preempts_prefetch() {
+
+        // Reference: a D-Cache line fill on an idle port
+        int preempted = 0;
+        mem_beat = -1;
+        int idle_latency = dcache_burst_latency(preempted);
+        CHECK(preempted == 0);
+        mem_eval();
+        mem_tick();  // The D-Cache stays quiet for a cycle
+
+        // A prefetch burst, two beats in
+        dut->icache_addr = 0xB010;
+        dut->icache_req = 1;
+        dut->icache_burst = 1;
+        dut->icache_prefetch = 1;
+        mem_eval();
+        CHECK(dut->m_addr == 0xB010);
+        mem_tick();  // Enter STATE_ICACHE
+        for (int beat = 0; beat < 2; beat++) {
+            mem_eval();
+            CHECK(dut->icache_ready == 1);
+            mem_tick();
+        }
+
+        // A D-Cache miss lands mid-prefetch: the prefetch is dropped and the D-Cache request
+        // goes out in the same cycle, so its latency is unchanged
+        dut->dcache_addr = 0xA000;
+        dut->dcache_req = 1;
+        eval();
+        CHECK(dut->icache_preempted == 1);
+        CHECK(dut->m_abort == 1);
+        CHECK(dut->m_addr == 0xA000);
+        CHECK(dut->icache_ready == 0);
+        int prefetch_latency = dcache_burst_latency(preempted);
+        CHECK(preempted == 1);
+        CHECK(prefetch_latency == idle_latency);
+        CHECK(idle_latency == 5);
+        mem_eval();
+        mem_tick();
+
+        // The I-Cache abandons a prefetch for a demand miss: the arbiter ends the burst
+        dut->icache_addr = 0xB010;
+        dut->icache_req = 1;
+        dut->icache_burst = 1;
+        dut->icache_prefetch = 1;
+        mem_eval();
+        mem_tick();  // Enter STATE_ICACHE
+        dut->icache_req = 0;
+        dut->icache_burst = 0;
+        dut->icache_prefetch = 0;
+        dut->icache_abort = 1;
+        mem_eval();
+        CHECK(dut->m_abort == 1);
+        CHECK(dut->m_req == 0);
+        CHECK(dut->icache_preempted == 0);
+        mem_tick();  // Back to IDLE
+        dut->icache_abort = 0;
+        mem_eval();
+        CHECK(dut->m_abort == 0);
+        CHECK(dut->m_req == 0);
+        mem_tick();
+    }
+
+    void test_dcache_abort() {
+
+        // The D-Cache abandons its prefetch burst after one beat
+        dut->m_ready = 0;
+        dut->dcache_addr = 0xC000;
+        dut->dcache_req = 1;
+        dut->dcache_burst = 1;
+        tick();  // Enter STATE_DCACHE
+        dut->m_ready = 1;
+        eval();
+        CHECK(dut->dcache_ready == 1);
+        tick();
+        dut->m_ready = 0;
+        dut->dcache_req = 0;
+        dut->dcache_burst = 0;
+        dut->dcache_abort = 1;
+        eval();
+        CHECK(dut->m_abort == 1);
+        CHECK(dut->m_req == 0);
+        tick();  // Back to IDLE
+        dut->dcache_abort = 0;
+
+        // The demand refill starts as a new 4-beat burst
+        dut->dcache_addr = 0xD000;
+        dut->dcache_req = 1;
+        dut->dcache_burst = 1;
+        eval();
+        CHECK(dut->m_abort == 0);
+        CHECK(dut->m_req == 1);
+        CHECK(dut->m_addr == 0xD000);
+        tick();  // Enter STATE_DCACHE
+        for (int beat = 0; beat < 4; beat++) {
+            INFO("beat " << beat);
+            CHECK(dut->m_req == 1);
+            dut->m_ready = 1;
+            eval();
+            CHECK(dut->dcache_ready == 1);
+            tick();
+        }
+        dut->m_ready = 0;
+        dut->dcache_req = 0;
+        dut->dcache_burst = 0;
+        eval();
+        CHECK(dut->m_req == 0);
+        tick();
+    }
 };
 
 TEST_CASE("L1 Arbiter") {
@@ -135,4 +388,8 @@ L1ArbiterTestbench tb;
         tb.test_icache_request();
         tb.test_dcache_priority();
         tb.test_dcache_write();
+        tb.test_icache_burst_holds_grant();
+        tb.test_prefetch_yields_to_dcache();
+        tb.test_dcache_preempts_prefetch();
+        tb.test_dcache_abort();
 }
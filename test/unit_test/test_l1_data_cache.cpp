@@ -3,14 +3,47 @@
 #include "tb_base.h"
 #include "Vl1_data_cache.h"
 #include <string>
+#include <unordered_map>
+
+// Configuration the RTL was verilated with (-GNUM_WAYS / -GWRITE_BACK / -GPREFETCH_ENABLE), set per build in CMake
+#ifndef L1D_NUM_WAYS
+#define L1D_NUM_WAYS 2
+#endif
+#ifndef L1D_WRITE_BACK
+#define L1D_WRITE_BACK 0
+#endif
+#ifndef L1D_PREFETCH
+#define L1D_PREFETCH 0
+#endif
+
+static constexpr uint32_t CACHE_BYTES = 4096;
+static constexpr uint32_t LINE_BYTES = 16;
+static constexpr uint32_t NUM_SETS = CACHE_BYTES / LINE_BYTES / L1D_NUM_WAYS;
+// Distance between two addresses that map to the same set
+static constexpr uint32_t SET_STRIDE = NUM_SETS * LINE_BYTES;
 
 class L1DataCacheTestbench : public ClockedTestbench<Vl1_data_cache> {
+    // Words written by the cache; everything else reads as memory_word()
+    std::unordered_map<uint32_t, uint32_t> memory;
+    int beat = 0; // Burst beat; the address is held and the words wrap within the line
+
 public:
+    // PC presented with every access (trains the stride prefetcher)
+    uint32_t pc = 0;
+
+    // Memory traffic caused by one CPU access
+    struct Traffic {
+        int reads = 0;
+        int writes = 0;
+        int stalls = 0; // Cycles the CPU waited
+    };
+
     L1DataCacheTestbench() : ClockedTestbench<Vl1_data_cache>(100, false) {
         // Initialize inputs
         dut->cpu_read_enable = 0;
         dut->cpu_write_enable = 0;
         dut->cpu_address = 0;
+        dut->cpu_program_counter = 0;
         dut->cpu_write_data = 0;
         dut->cpu_byte_enable = 0;
         dut->mem_ready = 0;
@@ -28,6 +61,85 @@ public:
         tick();
     }
     
+    // Initial backing memory content: every word is derived from its own address
+    static uint32_t memory_word(uint32_t addr) {
+        return 0xC0DE0000 ^ (addr & 0xFFFFFFFC);
+    }
+
+    uint32_t read_memory(uint32_t addr) {
+        addr &= 0xFFFFFFFC;
+        return memory.count(addr) ? memory[addr] : memory_word(addr);
+    }
+
+    // Answer the memory port for one cycle from the backing store
+    void serve_memory(Traffic& traffic) {
+        if (dut->mem_abort) beat = 0; // The burst in flight is dropped
+        if (dut->mem_request) {
+            uint32_t mem_addr = dut->mem_address & 0xFFFFFFFC;
+            if (dut->mem_burst) {
+                CHECK(dut->mem_write_enable == 0);
+                mem_addr = (mem_addr & ~0xFu) | ((mem_addr + beat * 4) & 0xFu);
+                beat = (beat + 1) % 4;
+            }
+            if (dut->mem_write_enable) {
+                memory[mem_addr] = dut->mem_write_data;
+                traffic.writes++;
+            } else {
+                dut->mem_read_data = read_memory(mem_addr);
+                traffic.reads++;
+            }
+            dut->mem_ready = 1;
+        }
+        tick();
+        dut->mem_ready = 0;
+        eval();
+    }
+
+    // Run one CPU access to completion, serving the memory port from the backing store
+    Traffic access(uint32_t addr, bool write, uint32_t wdata, uint32_t& rdata) {
+        dut->cpu_address = addr;
+        dut->cpu_program_counter = pc;
+        dut->cpu_read_enable = write ? 0 : 1;
+        dut->cpu_write_enable = write ? 1 : 0;
+        dut->cpu_write_data = wdata;
+        dut->cpu_byte_enable = write ? 0b1111 : 0;
+        eval();
+
+        Traffic traffic;
+        int timeout = 100;
+        while (dut->stall_cpu && timeout-- > 0) {
+            serve_memory(traffic);
+            traffic.stalls++;
+        }
+        REQUIRE(timeout > 0);
+
+        rdata = dut->cpu_read_data;
+        tick(); // Pipeline consumes the access on this edge
+        dut->cpu_read_enable = 0;
+        dut->cpu_write_enable = 0;
+        eval();
+        return traffic;
+    }
+
+    // Returns the number of refill beats the load needed (0 on a hit)
+    int load(uint32_t addr, uint32_t& data) {
+        return access(addr, false, 0, data).reads;
+    }
+
+    Traffic store(uint32_t addr, uint32_t data) {
+        uint32_t unused = 0;
+        return access(addr, true, data, unused);
+    }
+
+    // Cycles without CPU accesses; returns the memory reads the cache made meanwhile (prefetches)
+    int idle(int cycles) {
+        Traffic traffic;
+        for (int c = 0; c < cycles; c++) {
+            serve_memory(traffic);
+        }
+        return traffic.reads;
+    }
+
     void test_read_miss() {
         
         // Read from address
@@ -35,11 +147,13 @@ public:
         dut->cpu_read_enable = 1;
         tick();
         
-        // Should stall and request memory
+        // Should stall and request one burst for the whole line
         CHECK(dut->stall_cpu == 1);
         CHECK(dut->mem_request == 1);
+        CHECK(dut->mem_burst == 1);
+        CHECK(dut->mem_address == 0x2000);
         
-        // Simulate memory responses for 4-word cache line
+        // Simulate the 4 burst beats of the cache line
         for (int i = 0; i < 4; i++) {
             dut->mem_read_data = 0xAABBCC00 + i;
             dut->mem_ready = 1;
@@ -83,6 +197,226 @@ public:
         dut->mem_ready = 0;
         dut->cpu_write_enable = 0;
         tick();
+
+        // The hit line was updated in place
+        uint32_t data = 0;
+        CHECK(load(0x2004, data) == 0);
+        CHECK(data == 0x12345678);
+    }
+
+    void test_write_back() {
+        uint32_t data = 0;
+
+        // Store hit: finishes without stalling and without touching memory
+        dut->cpu_address = 0x2004;
+        dut->cpu_write_data = 0x12345678;
+        dut->cpu_byte_enable = 0b1111;
+        dut->cpu_write_enable = 1;
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->mem_request == 0);
+        tick();
+        dut->cpu_write_enable = 0;
+        eval();
+
+        CHECK(load(0x2004, data) == 0);
+        CHECK(data == 0x12345678);
+        CHECK(read_memory(0x2004) == memory_word(0x2004));
+
+        // Store miss: the line is allocated first, then the store hits in it
+        Traffic miss = store(0x3008, 0xCAFEF00D);
+        CHECK(miss.reads == 4);
+        CHECK(miss.writes == 0);
+        CHECK(load(0x3008, data) == 0);
+        CHECK(data == 0xCAFEF00D);
+        CHECK(load(0x300C, data) == 0);
+        CHECK(data == memory_word(0x300C));
+    }
+
+    void test_dirty_eviction() {
+        const uint32_t base = 0x6020;
+        uint32_t data = 0;
+
+        // Dirty every way of one set
+        for (uint32_t w = 0; w < L1D_NUM_WAYS; w++) {
+            uint32_t addr = base + w * SET_STRIDE;
+            Traffic fill = store(addr, 0xD1870000 + w);
+            CHECK(fill.reads == 4);
+            CHECK(fill.writes == 0);
+            CHECK(read_memory(addr) == memory_word(addr));
+        }
+
+        // A conflicting load writes the PLRU victim (way 0) back before refilling
+        uint32_t intruder = base + L1D_NUM_WAYS * SET_STRIDE;
+        Traffic evict = access(intruder, false, 0, data);
+        CHECK(evict.writes == 4);
+        CHECK(evict.reads == 4);
+        CHECK(data == memory_word(intruder));
+        CHECK(read_memory(base) == 0xD1870000);
+        CHECK(read_memory(base + 4) == memory_word(base + 4));
+
+        // The written-back line reads back from memory
+        Traffic reload = access(base, false, 0, data);
+        CHECK(reload.reads == 4);
+        CHECK(data == 0xD1870000);
+
+        // Clean victims are dropped without a writeback
+        const uint32_t clean_base = 0x7040;
+        for (uint32_t w = 0; w < L1D_NUM_WAYS; w++) {
+            load(clean_base + w * SET_STRIDE, data);
+        }
+        Traffic clean = access(clean_base + L1D_NUM_WAYS * SET_STRIDE, false, 0, data);
+        CHECK(clean.reads == 4);
+        CHECK(clean.writes == 0);
+
+        // Peripheral stores are never allocated
+        Traffic mmio = store(0x40000000, 'A');
+        CHECK(mmio.writes == 1);
+        CHECK(mmio.reads == 0);
+    }
+
+    void test_set_conflicts() {
+        INFO("NUM_WAYS = " << L1D_NUM_WAYS);
+        const uint32_t base = 0x8040;
+        uint32_t data = 0;
+
+        // Fill every way of one set: each line misses once, then hits
+        for (uint32_t w = 0; w < L1D_NUM_WAYS; w++) {
+            uint32_t addr = base + w * SET_STRIDE;
+            CHECK(load(addr, data) == 4);
+            CHECK(data == memory_word(addr));
+            CHECK(load(addr + 8, data) == 0);
+            CHECK(data == memory_word(addr + 8));
+        }
+
+        // All ways are still resident
+        for (uint32_t w = 0; w < L1D_NUM_WAYS; w++) {
+            uint32_t addr = base + w * SET_STRIDE + 4;
+            CHECK(load(addr, data) == 0);
+            CHECK(data == memory_word(addr));
+        }
+
+        // One more conflicting line evicts the pseudo-LRU way (way 0 after an in-order sweep)
+        uint32_t intruder = base + L1D_NUM_WAYS * SET_STRIDE;
+        CHECK(load(intruder, data) == 4);
+        CHECK(data == memory_word(intruder));
+        CHECK(load(intruder, data) == 0);
+
+        for (uint32_t w = 1; w < L1D_NUM_WAYS; w++) {
+            uint32_t addr = base + w * SET_STRIDE;
+            CHECK(load(addr, data) == 0);
+            CHECK(data == memory_word(addr));
+        }
+
+        // The evicted line has to be fetched again
+        CHECK(load(base, data) == 4);
+        CHECK(data == memory_word(base));
+    }
+
+    void test_recently_used_line_survives() {
+        const uint32_t base = 0x4080;
+        uint32_t data = 0;
+
+        if (L1D_NUM_WAYS < 2) {
+            return;
+        }
+
+        for (uint32_t w = 0; w < L1D_NUM_WAYS; w++) {
+            load(base + w * SET_STRIDE, data);
+        }
+
+        // Touch way 0 again so it is no longer the replacement candidate
+        CHECK(load(base, data) == 0);
+
+        uint32_t intruder = base + L1D_NUM_WAYS * SET_STRIDE;
+        CHECK(load(intruder, data) == 4);
+        CHECK(load(base, data) == 0);
+        CHECK(data == memory_word(base));
+    }
+
+    void test_stride_prefetch() {
+        INFO("PREFETCH_ENABLE = " << L1D_PREFETCH);
+        uint32_t data = 0;
+
+        // One load walking an array with a 64-byte stride: the third access confirms the stride
+        pc = 0x100;
+        for (uint32_t i = 0; i < 3; i++) {
+            CHECK(load(0x9000 + i * 64, data) == 4);
+        }
+
+        // PREFETCH_DEGREE (2) lines are fetched, starting one stride ahead, in idle cycles only
+        CHECK(idle(30) == (L1D_PREFETCH ? 8 : 0));
+        CHECK(load(0x90C0, data) == (L1D_PREFETCH ? 0 : 4));
+        CHECK(data == memory_word(0x90C0));
+        CHECK(load(0x9100, data) == (L1D_PREFETCH ? 0 : 4));
+        CHECK(data == memory_word(0x9100));
+    }
+
+    void test_stream_prefetch() {
+        INFO("PREFETCH_ENABLE = " << L1D_PREFETCH);
+        uint32_t data = 0;
+
+        // Word-by-word walk: strides shorter than a line prefetch the following lines
+        pc = 0x200;
+        CHECK(load(0xA000, data) == 4);
+        CHECK(load(0xA004, data) == 0);
+        CHECK(load(0xA008, data) == 0);
+
+        // Read hits are served while the prefetch refill is in flight
+        idle(2);
+        pc = 0x204;
+        CHECK(load(0xA00C, data) == 0);
+        CHECK(data == memory_word(0xA00C));
+
+        idle(30);
+        CHECK(load(0xA010, data) == (L1D_PREFETCH ? 0 : 4));
+        CHECK(load(0xA020, data) == (L1D_PREFETCH ? 0 : 4));
+        CHECK(data == memory_word(0xA020));
+    }
+
+    void test_prefetch_fill_without_access() {
+        INFO("PREFETCH_ENABLE = " << L1D_PREFETCH);
+        uint32_t data = 0;
+
+        pc = 0x300;
+        for (uint32_t i = 0; i < 3; i++) {
+            load(0xB000 + i * 64, data);
+        }
+
+        // The prefetch fills never stall the CPU while it makes no access (without a store
+        // buffer, stall_cpu stalls the whole pipeline)
+        Traffic traffic;
+        for (int c = 0; c < 20; c++) {
+            eval();
+            CHECK(dut->stall_cpu == 0);
+            serve_memory(traffic);
+        }
+        CHECK(traffic.reads == (L1D_PREFETCH ? 8 : 0));
+    }
+
+    void test_demand_miss_preempts_prefetch() {
+        INFO("PREFETCH_ENABLE = " << L1D_PREFETCH);
+        uint32_t data = 0;
+
+        pc = 0x304;
+        int miss_stalls = 0;
+        for (uint32_t i = 0; i < 3; i++) {
+            miss_stalls = access(0xC000 + i * 64, false, 0, data).stalls;
+        }
+
+        // A read miss to another line one beat into the prefetch burst drops the burst: it waits
+        // one extra cycle (the abort), not for the rest of the prefetch
+        CHECK(idle(2) == (L1D_PREFETCH ? 1 : 0));
+        pc = 0x308;
+        Traffic traffic = access(0xD000, false, 0, data);
+        CHECK(traffic.reads == 4);
+        CHECK(traffic.stalls == miss_stalls + (L1D_PREFETCH ? 1 : 0));
+        CHECK(data == memory_word(0xD000));
+
+        // The abandoned line was not installed
+        pc = 0x30C;
+        CHECK(load(0xC0C0, data) == 4);
+        CHECK(data == memory_word(0xC0C0));
     }
 };
 
@@ -91,5 +425,30 @@ L1DataCacheTestbench tb;
         
         tb.reset();
         tb.test_read_miss();
+#if L1D_WRITE_BACK
+        tb.test_write_back();
+#else
         tb.test_write_through();
+#endif
+}
+
+TEST_CASE("L1 Data Cache Set Conflicts") {
+L1DataCacheTestbench tb;
+
+        tb.reset();
+        tb.test_set_conflicts();
+        tb.test_recently_used_line_survives();
+#if L1D_WRITE_BACK
+        tb.test_dirty_eviction();
+#endif
+}
+
+TEST_CASE("L1 Data Cache Stride Prefetch") {
+L1DataCacheTestbench tb;
+
+        tb.reset();
+        tb.test_stride_prefetch();
+        tb.test_stream_prefetch();
+        tb.test_prefetch_fill_without_access();
+        tb.test_demand_miss_preempts_prefetch();
 }
@@ -2,8 +2,13 @@
 #include "doctest.h"
 #include "tb_base.h"
 #include "Vl1_inst_cache.h"
+#include "Vl1_inst_cache___024root.h"
 #include <string>
 
+#ifndef L1I_PREFETCH
+#define L1I_PREFETCH 0
+#endif
+
 class L1InstCacheTestbench : public ClockedTestbench<Vl1_inst_cache> {
 public:
     L1InstCacheTestbench() : ClockedTestbench<Vl1_inst_cache>(100, false) {
@@ -11,6 +16,7 @@ public:
         dut->program_counter_address = 0;
         dut->instruction_memory_read_data = 0;
         dut->instruction_memory_ready = 0;
+        dut->instruction_memory_preempted = 0;
     }
     
     void set_clk(uint8_t value) override {
@@ -33,10 +39,11 @@ public:
         CHECK(dut->stall_cpu == 1);
         CHECK(dut->instruction_memory_request == 1);
         
-        // Simulate memory responses for 4-word cache line
+        // Simulate the 4 beats of the line-fill burst (address held for the whole burst)
         for (int i = 0; i < 4; i++) {
-            INFO((std::string("Memory addr ") + std::to_string(i)).c_str());
-            CHECK(dut->instruction_memory_address == (0x1000 + (i * 4)));
+            INFO((std::string("Burst beat ") + std::to_string(i)).c_str());
+            CHECK(dut->instruction_memory_address == 0x1000);
+            CHECK(dut->instruction_memory_burst == 1);
             
             dut->instruction_memory_read_data = 0x00000013 + i;  // NOP variants
             dut->instruction_memory_ready = 1;
@@ -68,12 +75,17 @@ public:
         tick();
         CHECK(dut->stall_cpu == 0);
         CHECK(dut->instruction == 0x00000015);
+
+        // Dual fetch: the next word of the line comes with the hit
+        CHECK(dut->second_instruction_valid == 1);
+        CHECK(dut->second_instruction == 0x00000016);
         
-        // Hit on word 3 (offset 12)
+        // Hit on word 3 (offset 12): the last word has no second word in the line
         dut->program_counter_address = 0x100C;
         tick();
         CHECK(dut->stall_cpu == 0);
         CHECK(dut->instruction == 0x00000016);
+        CHECK(dut->second_instruction_valid == 0);
     }
     
     void test_different_line() {
@@ -102,13 +114,210 @@ public:
         CHECK(dut->stall_cpu == 0);
         CHECK(dut->instruction == 0xAAAA0000);
     }
+
+    void test_critical_word_first() {
+
+        // Miss on word 2 of a new line
+        dut->program_counter_address = 0x3008;
+        tick();
+        CHECK(dut->stall_cpu == 1);
+
+        // The burst starts at the missing word
+        CHECK(dut->instruction_memory_request == 1);
+        CHECK(dut->instruction_memory_burst == 1);
+        CHECK(dut->instruction_memory_address == 0x3008);
+
+        // Early restart: the missing word is released as soon as it arrives
+        dut->instruction_memory_read_data = 0xC0000002;
+        dut->instruction_memory_ready = 1;
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xC0000002);
+        tick();
+
+        // The next word has not arrived yet
+        dut->instruction_memory_ready = 0;
+        dut->program_counter_address = 0x300C;
+        eval();
+        CHECK(dut->stall_cpu == 1);
+
+        // Remaining beats wrap around the line: 3, 0, 1
+        const uint32_t wrap_pc[3] = {0x300C, 0x3000, 0x3004};
+        const uint32_t wrap_data[3] = {0xC0000003, 0xC0000000, 0xC0000001};
+        for (int beat = 0; beat < 3; beat++) {
+            INFO("beat " << beat + 1);
+            dut->program_counter_address = wrap_pc[beat];
+            dut->instruction_memory_read_data = wrap_data[beat];
+            dut->instruction_memory_ready = 1;
+            eval();
+            CHECK(dut->stall_cpu == 0);
+            CHECK(dut->instruction == wrap_data[beat]);
+            tick();
+        }
+        dut->instruction_memory_ready = 0;
+
+        // Words that already arrived are served while the line is installed
+        dut->program_counter_address = 0x3008;
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xC0000002);
+        tick();
+
+        // Installed in address order
+        for (int w = 0; w < 4; w++) {
+            dut->program_counter_address = 0x3000 + w * 4;
+            eval();
+            CHECK(dut->stall_cpu == 0);
+            CHECK(dut->instruction == 0xC0000000u + w);
+        }
+        tick();
+    }
+
+    // Return the 4 beats of a line-aligned burst
+    void feed_burst(uint32_t data_base) {
+        for (int beat = 0; beat < 4; beat++) {
+            dut->instruction_memory_read_data = data_base + beat;
+            dut->instruction_memory_ready = 1;
+            tick();
+        }
+        dut->instruction_memory_ready = 0;
+    }
+
+    void test_next_line_prefetch() {
+
+        // Demand miss on line 0x4000
+        dut->program_counter_address = 0x4000;
+        tick();
+        CHECK(dut->instruction_memory_prefetch == 0);
+        feed_burst(0xD0000000);
+        tick();  // Install
+
+        // A hit on line N starts the prefetch of line N+1
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        tick();
+        CHECK(dut->instruction_memory_request == 1);
+        CHECK(dut->instruction_memory_burst == 1);
+        CHECK(dut->instruction_memory_prefetch == 1);
+        CHECK(dut->instruction_memory_address == 0x4010);
+
+        // Line N keeps hitting while the prefetch streams in
+        for (int beat = 0; beat < 4; beat++) {
+            INFO("beat " << beat);
+            dut->program_counter_address = 0x4000 + beat * 4;
+            dut->instruction_memory_read_data = 0xD1000000 + beat;
+            dut->instruction_memory_ready = 1;
+            eval();
+            CHECK(dut->stall_cpu == 0);
+            CHECK(dut->instruction == 0xD0000000u + beat);
+            tick();
+        }
+        dut->instruction_memory_ready = 0;
+
+        // Line N+1 is served from the stream buffer without a miss and promoted
+        dut->program_counter_address = 0x4010;
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xD1000000);
+        CHECK(dut->instruction_memory_request == 0);
+        tick();
+        CHECK(dut->rootp->l1_inst_cache__DOT__prefetch_useful == 1);
+        dut->program_counter_address = 0x4014;
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xD1000001);
+        tick();
+
+        // Promoted line hits in the cache and prefetches the one after it
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xD1000001);
+        tick();
+        CHECK(dut->instruction_memory_address == 0x4020);
+        feed_burst(0xD2000000);
+
+        // Jump away: the demand miss goes out, the buffered line stays unused
+        dut->program_counter_address = 0x6000;
+        tick();
+        CHECK(dut->instruction_memory_prefetch == 0);
+        CHECK(dut->instruction_memory_address == 0x6000);
+        feed_burst(0xE0000000);
+        tick();  // Install
+
+        // The next prefetch replaces it and counts it as useless
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        tick();
+        CHECK(dut->rootp->l1_inst_cache__DOT__prefetch_useless == 1);
+        CHECK(dut->instruction_memory_address == 0x6010);
+
+        // A demand miss to another line abandons the prefetch in flight and goes out at once
+        dut->instruction_memory_read_data = 0xE1000000;
+        dut->instruction_memory_ready = 1;
+        tick();  // First beat of line 0x6010
+        dut->instruction_memory_ready = 0;
+        dut->program_counter_address = 0x7000;
+        eval();
+        CHECK(dut->stall_cpu == 1);
+        CHECK(dut->instruction_memory_abort == 1);
+        CHECK(dut->instruction_memory_request == 0);
+        tick();
+        CHECK(dut->rootp->l1_inst_cache__DOT__prefetch_aborted == 1);
+        CHECK(dut->instruction_memory_abort == 0);
+        CHECK(dut->instruction_memory_prefetch == 0);
+        CHECK(dut->instruction_memory_address == 0x7000);
+        feed_burst(0xF0000000);
+        tick();
+
+        dut->program_counter_address = 0x7000;
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xF0000000);
+        tick();
+
+        // The arbiter preempts the next prefetch for the D-Cache: the partial line is
+        // dropped and the prefetch starts over
+        CHECK(dut->instruction_memory_prefetch == 1);
+        CHECK(dut->instruction_memory_address == 0x7010);
+        dut->instruction_memory_read_data = 0xF1000000;
+        dut->instruction_memory_ready = 1;
+        tick();
+        dut->instruction_memory_ready = 0;
+        dut->instruction_memory_preempted = 1;
+        tick();
+        dut->instruction_memory_preempted = 0;
+        CHECK(dut->rootp->l1_inst_cache__DOT__prefetch_aborted == 2);
+        CHECK(dut->rootp->l1_inst_cache__DOT__stream_valid == 0);
+        tick();
+        CHECK(dut->instruction_memory_prefetch == 1);
+        CHECK(dut->instruction_memory_address == 0x7010);
+
+        // A miss on the line being prefetched waits for it instead
+        dut->program_counter_address = 0x7010;
+        eval();
+        CHECK(dut->stall_cpu == 1);
+        CHECK(dut->instruction_memory_abort == 0);
+        CHECK(dut->instruction_memory_address == 0x7010);
+        feed_burst(0xF1000000);
+        eval();
+        CHECK(dut->stall_cpu == 0);
+        CHECK(dut->instruction == 0xF1000000);
+        tick();
+        CHECK(dut->rootp->l1_inst_cache__DOT__prefetch_useful == 2);
+        CHECK(dut->rootp->l1_inst_cache__DOT__prefetch_aborted == 2);
+    }
 };
 
 TEST_CASE("L1 Inst Cache") {
 L1InstCacheTestbench tb;
         
         tb.reset();
+#if L1I_PREFETCH
+        tb.test_next_line_prefetch();
+#else
         tb.test_cold_miss();
         tb.test_sequential_hits();
         tb.test_different_line();
+        tb.test_critical_word_first();
+#endif
 }
@@ -2,6 +2,11 @@
 #include "doctest.h"
 #include "tb_base.h"
 #include "Vmdu.h"
+#include <cstdlib>
+
+#ifndef MDU_MUL_LATENCY
+#define MDU_MUL_LATENCY 1
+#endif
 
 // MDU Operations
 #define OP_MUL    0b000
@@ -15,7 +20,8 @@
 
 /**
  * MDU (Multiply-Divide Unit) Testbench
- * Tests multiply and divide operations including signed/unsigned variants
+ * Tests multiply and divide operations including signed/unsigned variants.
+ * Built once per multiplier latency (MDU_MUL_LATENCY).
  */
 class MDUTestbench : public ClockedTestbench<Vmdu> {
 public:
@@ -25,6 +31,7 @@ public:
         dut->operation = 0;
         dut->operand_a = 0;
         dut->operand_b = 0;
+        dut->tag = 0;
     }
     
     void set_clk(uint8_t value) override {
@@ -39,25 +46,56 @@ public:
         tick();
     }
     
+    // Cycles from start until ready in the last run_operation
+    int last_cycles = 0;
+
     uint32_t run_operation(uint8_t op, uint32_t a, uint32_t b) {
         dut->operation = op;
         dut->operand_a = a;
         dut->operand_b = b;
         dut->start = 1;
-        tick();
-        dut->start = 0;
+        eval();
         
-        // Wait for ready
+        // Wait for ready (a combinational multiply is ready in the start cycle)
         int timeout = 100;
+        last_cycles = 0;
         while (!dut->ready && timeout-- > 0) {
             tick();
+            dut->start = 0;
+            eval();
+            last_cycles++;
         }
         
         if (timeout <= 0) {
             throw std::runtime_error("MDU operation timeout");
         }
         
-        return dut->result;
+        uint32_t res = dut->result;
+        dut->start = 0;
+        tick();
+        return res;
+    }
+
+    // Reference model (RISC-V M extension)
+    static uint32_t reference(uint8_t op, uint32_t a, uint32_t b) {
+        int64_t sa = static_cast<int32_t>(a);
+        int64_t sb = static_cast<int32_t>(b);
+        switch (op) {
+            case OP_MUL:    return static_cast<uint32_t>(a * b);
+            case OP_MULH:   return static_cast<uint32_t>(static_cast<uint64_t>(sa * sb) >> 32);
+            case OP_MULHSU: return static_cast<uint32_t>(static_cast<uint64_t>(sa * static_cast<int64_t>(b)) >> 32);
+            case OP_MULHU:  return static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 32);
+            case OP_DIV:
+                if (b == 0) return 0xFFFFFFFF;
+                if (a == 0x80000000 && b == 0xFFFFFFFF) return a;
+                return static_cast<uint32_t>(sa / sb);
+            case OP_DIVU:   return b == 0 ? 0xFFFFFFFF : a / b;
+            case OP_REM:
+                if (b == 0) return a;
+                if (a == 0x80000000 && b == 0xFFFFFFFF) return 0;
+                return static_cast<uint32_t>(sa % sb);
+            default:        return b == 0 ? a : a % b;
+        }
     }
     
     void test_multiply() {
@@ -101,6 +139,105 @@ public:
         CHECK(res == 123);
     }
     
+    void test_divide_early_termination() {
+
+        // One radix-4 step per 2 quotient bits, plus setup and done: udiv(12345, 10) has 11
+        CHECK(run_operation(OP_DIVU, 12345, 10) == 1234);
+        CHECK(last_cycles == 6 + 2);
+        CHECK(run_operation(OP_REMU, 12345, 10) == 5);
+        CHECK(last_cycles == 6 + 2);
+
+        // Full-width quotient; the tag comes back with the result
+        dut->tag = 21;
+        CHECK(run_operation(OP_DIVU, 0xFFFFFFFF, 1) == 0xFFFFFFFF);
+        CHECK(last_cycles == 16 + 2);
+        CHECK(dut->result_tag == 21);
+        dut->tag = 0;
+
+        // Dividend smaller than the divisor: no steps
+        CHECK(run_operation(OP_REM, 0xFFFFFFFB, 10) == 0xFFFFFFFB); // -5 % 10 = -5
+        CHECK(last_cycles == 2);
+
+        // Division by zero and signed overflow resolve in one cycle
+        CHECK(run_operation(OP_DIVU, 77, 0) == 0xFFFFFFFF);
+        CHECK(last_cycles == 1);
+        CHECK(run_operation(OP_REMU, 77, 0) == 77);
+        CHECK(last_cycles == 1);
+        CHECK(run_operation(OP_DIV, 0x80000000, 0xFFFFFFFF) == 0x80000000);
+        CHECK(last_cycles == 1);
+        CHECK(run_operation(OP_REM, 0x80000000, 0xFFFFFFFF) == 0);
+        CHECK(last_cycles == 1);
+    }
+
+    void test_multiply_high() {
+
+        // MULH -2 * 3 = -6 -> upper word all ones
+        CHECK(run_operation(OP_MULH, 0xFFFFFFFE, 3) == 0xFFFFFFFF);
+
+        // MULH min * min = 2^62
+        CHECK(run_operation(OP_MULH, 0x80000000, 0x80000000) == 0x40000000);
+
+        // MULHSU -1 * 0xFFFFFFFF (unsigned) = -(2^32 - 1)
+        CHECK(run_operation(OP_MULHSU, 0xFFFFFFFF, 0xFFFFFFFF) == 0xFFFFFFFF);
+
+        // MULHU 0xFFFFFFFF * 0xFFFFFFFF = 0xFFFFFFFE_00000001
+        CHECK(run_operation(OP_MULHU, 0xFFFFFFFF, 0xFFFFFFFF) == 0xFFFFFFFE);
+        CHECK(run_operation(OP_MUL, 0xFFFFFFFF, 0xFFFFFFFF) == 0x00000001);
+    }
+
+    void test_multiply_latency() {
+
+        // Independent multiplies start back to back; results (and their tags) come out
+        // MUL_LATENCY cycles later
+        const uint8_t ops[4] = {OP_MUL, OP_MULH, OP_MULHSU, OP_MULHU};
+        const uint32_t a[4] = {7, 0x80000000, 0xFFFFFFF0, 0x12345678};
+        const uint32_t b[4] = {6, 0x7FFFFFFF, 0x00000100, 0x9ABCDEF0};
+        int received = 0;
+        for (int cycle = 0; cycle < 4 + MDU_MUL_LATENCY; cycle++) {
+            if (cycle < 4) {
+                dut->operation = ops[cycle];
+                dut->operand_a = a[cycle];
+                dut->operand_b = b[cycle];
+                dut->tag = 10 + cycle;
+                dut->start = 1;
+            } else {
+                dut->start = 0;
+            }
+            eval();
+            INFO("cycle " << cycle);
+            CHECK(dut->busy == 0);
+            int issued = cycle - MDU_MUL_LATENCY;
+            CHECK(dut->ready == (issued >= 0 ? 1 : 0));
+            if (issued >= 0 && dut->ready) {
+                CHECK(dut->result == reference(ops[issued], a[issued], b[issued]));
+                CHECK(dut->result_tag == 10 + issued);
+                received++;
+            }
+            tick();
+        }
+        CHECK(received == 4);
+        dut->tag = 0;
+        eval();
+        CHECK(dut->ready == 0);
+    }
+
+    void test_random() {
+
+        // Every operation against the reference model
+        srand(12345);
+        for (int i = 0; i < 200; i++) {
+            uint8_t op = rand() % 8;
+            uint32_t a = (static_cast<uint32_t>(rand()) << 16) ^ rand();
+            uint32_t b = (static_cast<uint32_t>(rand()) << 16) ^ rand();
+            if (i % 10 == 0) b = 0;
+            if (i % 10 == 1) { a = 0x80000000; b = 0xFFFFFFFF; }
+            if (i % 10 == 2) b &= 0xFF;
+            if (i % 10 == 3) a &= 0xFFFF;
+            INFO("op " << int(op) << " a=" << a << " b=" << b);
+            CHECK(run_operation(op, a, b) == reference(op, a, b));
+        }
+    }
+    
     void test_unsigned_operations() {
         
         // DIVU (unsigned divide)
@@ -121,4 +258,8 @@ MDUTestbench tb;
         tb.test_divide();
         tb.test_remainder();
         tb.test_unsigned_operations();
+        tb.test_divide_early_termination();
+        tb.test_multiply_high();
+        tb.test_multiply_latency();
+        tb.test_random();
 }
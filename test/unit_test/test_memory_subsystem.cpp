@@ -15,6 +15,7 @@ public:
         dut->dcache_mem_wdata = 0;
         dut->dcache_mem_be = 0;
         dut->dcache_mem_we = 0;
+        dut->dcache_mem_burst = 0;
     }
     
     void set_clk(uint8_t value) override {
@@ -101,6 +102,51 @@ public:
         dut->dcache_mem_req = 0;
         tick();
     }
+
+    void write_word(uint32_t addr, uint32_t data) {
+        dut->dcache_mem_addr = addr;
+        dut->dcache_mem_wdata = data;
+        dut->dcache_mem_be = 0b1111;
+        dut->dcache_mem_we = 1;
+        dut->dcache_mem_req = 1;
+        for (int i = 0; i < 50 && !dut->dcache_mem_ready; i++) {
+            tick();
+        }
+        dut->dcache_mem_req = 0;
+        dut->dcache_mem_we = 0;
+        tick();
+    }
+
+    void test_dcache_burst_read() {
+        for (int w = 0; w < 4; w++) {
+            write_word(0x2000 + w * 4, 0xB0B00000 + w);
+        }
+
+        // Burst starting at word 2: the latency is paid once, then 4 back-to-back beats
+        dut->dcache_mem_addr = 0x2008;
+        dut->dcache_mem_burst = 1;
+        dut->dcache_mem_req = 1;
+
+        int latency = 0;
+        do {
+            tick();
+            latency++;
+        } while (!dut->dcache_mem_ready && latency < 50);
+        CHECK(latency == 3);
+
+        const uint32_t wrap_order[4] = {2, 3, 0, 1};
+        for (int beat = 0; beat < 4; beat++) {
+            INFO("beat " << beat);
+            CHECK(dut->dcache_mem_ready == 1);
+            CHECK(dut->dcache_mem_rdata == 0xB0B00000 + wrap_order[beat]);
+            tick();
+        }
+        CHECK(dut->dcache_mem_ready == 0);
+
+        dut->dcache_mem_req = 0;
+        dut->dcache_mem_burst = 0;
+        tick();
+    }
 };
 
 TEST_CASE("Memory Subsystem") {
@@ -110,4 +156,5 @@ MemorySubsystemTestbench tb;
         tb.test_icache_read();
         tb.test_dcache_write();
         tb.test_dcache_read();
+        tb.test_dcache_burst_read();
 }
@@ -4,6 +4,10 @@
 #include "Vregfile.h"
 #include <iostream>
 
+#ifndef REGFILE_THREADS
+#define REGFILE_THREADS 1
+#endif
+
 /**
  * Register File Testbench
  */
@@ -11,11 +15,20 @@ class RegfileTestbench : public ClockedTestbench<Vregfile> {
 public:
     RegfileTestbench() : ClockedTestbench<Vregfile>(100, false) {
         // Initialize inputs
+        dut->thread = 0;
         dut->write_enable = 0;
         dut->rs1_index = 0;
         dut->rs2_index = 0;
         dut->rd_index = 0;
         dut->write_data = 0;
+        dut->write_enable_2 = 0;
+        dut->rd_index_2 = 0;
+        dut->write_data_2 = 0;
+        dut->write_enable_3 = 0;
+        dut->rd_index_3 = 0;
+        dut->write_data_3 = 0;
+        dut->rs3_index = 0;
+        dut->rs4_index = 0;
         
     }
     
@@ -109,6 +122,134 @@ public:
         CHECK(dut->rs2_read_data == 0x22222222);
         
     }
+
+    // Test the second write port (out-of-band MDU results)
+    void test_second_write_port() {
+
+        // Both ports write different registers in the same cycle
+        dut->rd_index = 6;
+        dut->write_data = 0x66666666;
+        dut->write_enable = 1;
+        dut->rd_index_2 = 7;
+        dut->write_data_2 = 0x77777777;
+        dut->write_enable_2 = 1;
+
+        // Write-through from both ports before the edge
+        dut->rs1_index = 6;
+        dut->rs2_index = 7;
+        eval();
+        CHECK(dut->rs1_read_data == 0x66666666);
+        CHECK(dut->rs2_read_data == 0x77777777);
+        tick();
+
+        // Same register: port 2 is the younger write and wins
+        dut->rd_index = 8;
+        dut->write_data = 0x88888888;
+        dut->rd_index_2 = 8;
+        dut->write_data_2 = 0x99999999;
+        dut->rs1_index = 8;
+        eval();
+        CHECK(dut->rs1_read_data == 0x99999999);
+        tick();
+        dut->write_enable = 0;
+        dut->write_enable_2 = 0;
+
+        CHECK(read_rs1(6) == 0x66666666);
+        CHECK(read_rs2(7) == 0x77777777);
+        CHECK(read_rs1(8) == 0x99999999);
+
+        // x0 stays zero
+        dut->rd_index_2 = 0;
+        dut->write_data_2 = 0xFFFFFFFF;
+        dut->write_enable_2 = 1;
+        tick();
+        dut->write_enable_2 = 0;
+        CHECK(read_rs1(0) == 0);
+    }
+
+    // Test the second pipe's ports: reads 3/4 and write port 3
+    void test_second_pipe_ports() {
+
+        // Four reads in the same cycle
+        dut->rs1_index = 5;
+        dut->rs2_index = 10;
+        dut->rs3_index = 10;
+        dut->rs4_index = 5;
+        eval();
+        CHECK(dut->rs1_read_data == 0x11111111);
+        CHECK(dut->rs2_read_data == 0x22222222);
+        CHECK(dut->rs3_read_data == 0x22222222);
+        CHECK(dut->rs4_read_data == 0x11111111);
+
+        // Both WB writes of a pair to the same register: port 3 (the younger pipe) wins,
+        // seen through write-through on every read port
+        dut->rd_index = 12;
+        dut->write_data = 0xCCCC0000;
+        dut->write_enable = 1;
+        dut->rd_index_3 = 12;
+        dut->write_data_3 = 0xCCCC0003;
+        dut->write_enable_3 = 1;
+        dut->rs1_index = 12;
+        dut->rs3_index = 12;
+        eval();
+        CHECK(dut->rs1_read_data == 0xCCCC0003);
+        CHECK(dut->rs3_read_data == 0xCCCC0003);
+        tick();
+        dut->write_enable = 0;
+
+        // An MDU result (port 2) wins over port 3
+        dut->rd_index_3 = 13;
+        dut->write_data_3 = 0xDDDD0003;
+        dut->rd_index_2 = 13;
+        dut->write_data_2 = 0xDDDD0002;
+        dut->write_enable_2 = 1;
+        dut->rs4_index = 13;
+        eval();
+        CHECK(dut->rs4_read_data == 0xDDDD0002);
+        tick();
+        dut->write_enable_2 = 0;
+        dut->write_enable_3 = 0;
+
+        CHECK(read_rs1(12) == 0xCCCC0003);
+        CHECK(read_rs2(13) == 0xDDDD0002);
+        dut->rs4_index = 0;
+        eval();
+        CHECK(dut->rs4_read_data == 0);
+    }
+
+    // Test per-context banks (hardware threads)
+    void test_thread_banks() {
+
+        // Every context starts with its own stack pointer
+        for (int t = 0; t < REGFILE_THREADS; t++) {
+            dut->thread = t;
+            CHECK(read_rs1(2) == 0x02000000);
+        }
+
+        // The same architectural register in each context
+        for (int t = 0; t < REGFILE_THREADS; t++) {
+            dut->thread = t;
+            write_reg(20, 0x70000000 | t);
+        }
+        for (int t = 0; t < REGFILE_THREADS; t++) {
+            dut->thread = t;
+            CHECK(read_rs1(20) == (0x70000000u | t));
+            CHECK(read_rs2(5) == (t == 0 ? 0xA0050005u : 0u)); // Only context 0 wrote x5
+        }
+
+        // Write-through forwarding is not affected by the bank
+        dut->thread = 1;
+        dut->rd_index = 21;
+        dut->write_data = 0x21212121;
+        dut->write_enable = 1;
+        dut->rs1_index = 21;
+        eval();
+        CHECK(dut->rs1_read_data == 0x21212121);
+        tick();
+        dut->write_enable = 0;
+        dut->thread = 0;
+        CHECK(read_rs1(21) == 0xA0150015);
+    }
 };
 
 TEST_CASE("Regfile") {
@@ -121,4 +262,9 @@ RegfileTestbench tb;
         tb.test_basic_rw();
         tb.test_dual_read();
         tb.test_all_registers();
+        tb.test_second_write_port();
+        tb.test_second_pipe_ports();
+#if REGFILE_THREADS > 1
+        tb.test_thread_banks();
+#endif
 }
@@ -0,0 +1,201 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "tb_base.h"
+#include "Vreturn_address_stack.h"
+#include "Vreturn_address_stack___024root.h"
+#include <string>
+
+/**
+ * Return Address Stack Testbench
+ * Calls push at fetch and returns pop, following the RISC-V JALR hints
+ * (x1/x5 are link registers). Resolved calls/returns update a
+ * non-speculative copy that a flush restores.
+ */
+class ReturnAddressStackTestbench : public ClockedTestbench<Vreturn_address_stack> {
+public:
+    // Encodings
+    static constexpr uint32_t JAL_RA      = 0x000000EF; // jal  ra, 0
+    static constexpr uint32_t JAL_T0      = 0x000002EF; // jal  t0, 0
+    static constexpr uint32_t RET         = 0x00008067; // jalr x0, 0(ra)
+    static constexpr uint32_t JALR_RA_T0  = 0x000280E7; // jalr ra, 0(t0): pop, then push
+    static constexpr uint32_t JALR_RA_RA  = 0x000080E7; // jalr ra, 0(ra): push only
+    static constexpr uint32_t ADDI_NOP    = 0x00000013;
+
+    ReturnAddressStackTestbench() : ClockedTestbench<Vreturn_address_stack>(100, false) {
+        dut->rst_n = 0;
+        dut->fetch_program_counter = 0;
+        dut->fetch_instruction = ADDI_NOP;
+        dut->fetch_advance = 0;
+        dut->execute_program_counter = 0;
+        dut->is_jump_execute = 0;
+        dut->is_jalr_execute = 0;
+        dut->rd_index_execute = 0;
+        dut->rs1_index_execute = 0;
+        dut->execute_advance = 0;
+        dut->mispredict_execute = 0;
+        dut->decode_program_counter = 0;
+        dut->decode_instruction = ADDI_NOP;
+        dut->restore_decode = 0;
+        dut->restore = 0;
+    }
+
+    void set_clk(uint8_t value) override {
+        dut->clk = value;
+    }
+
+    void reset() {
+        dut->rst_n = 0;
+        tick();
+        dut->rst_n = 1;
+        tick();
+    }
+
+    // Target of the last predicted return
+    uint32_t last_target = 0;
+
+    // Fetch one instruction; returns whether a return was predicted (target in last_target)
+    bool fetch(uint32_t pc, uint32_t instruction) {
+        dut->fetch_program_counter = pc;
+        dut->fetch_instruction = instruction;
+        eval();
+        bool predicted = dut->predict_return;
+        last_target = dut->return_target;
+        dut->fetch_advance = 1;
+        tick();
+        dut->fetch_advance = 0;
+        dut->fetch_instruction = ADDI_NOP;
+        eval();
+        return predicted;
+    }
+
+    // A jump leaves EX
+    void execute(uint32_t pc, bool jalr, int rd, int rs1, bool mispredict) {
+        dut->execute_program_counter = pc;
+        dut->is_jump_execute = 1;
+        dut->is_jalr_execute = jalr ? 1 : 0;
+        dut->rd_index_execute = rd;
+        dut->rs1_index_execute = rs1;
+        dut->execute_advance = 1;
+        dut->mispredict_execute = mispredict ? 1 : 0;
+        tick();
+        dut->is_jump_execute = 0;
+        dut->execute_advance = 0;
+        dut->mispredict_execute = 0;
+        eval();
+    }
+
+    void restore() {
+        dut->restore = 1;
+        tick();
+        dut->restore = 0;
+        eval();
+    }
+
+    // ID redirect: restore, then replay the ID instruction's own push/pop
+    void restore_from_decode(uint32_t pc, uint32_t instruction) {
+        dut->decode_program_counter = pc;
+        dut->decode_instruction = instruction;
+        dut->restore_decode = 1;
+        dut->restore = 1;
+        tick();
+        dut->restore_decode = 0;
+        dut->restore = 0;
+        dut->decode_instruction = ADDI_NOP;
+        eval();
+    }
+
+    void peek_return(uint32_t pc, uint32_t instruction, bool exp_predict, uint32_t exp_target, const char* name) {
+        dut->fetch_program_counter = pc;
+        dut->fetch_instruction = instruction;
+        eval();
+        INFO(name);
+        CHECK(dut->predict_return == (exp_predict ? 1 : 0));
+        if (exp_predict) {
+            CHECK(dut->return_target == exp_target);
+        }
+        dut->fetch_instruction = ADDI_NOP;
+        eval();
+    }
+
+    void test_empty() {
+
+        // Nothing to predict from
+        peek_return(0x80, RET, false, 0, "Empty stack");
+    }
+
+    void test_nested_calls() {
+
+        // Two nested calls, returns in LIFO order
+        fetch(0x100, JAL_RA);
+        fetch(0x200, JAL_RA);
+        CHECK(fetch(0x300, RET));
+        CHECK(last_target == 0x204);
+        CHECK(fetch(0x208, RET));
+        CHECK(last_target == 0x104);
+        peek_return(0x108, RET, false, 0, "Stack empty again");
+    }
+
+    void test_hints() {
+
+        // x5 is a link register too
+        fetch(0x400, JAL_T0);
+        peek_return(0x500, JALR_RA_RA, false, 0, "rd == rs1 == ra pushes only");
+
+        // rd and rs1 different links: pop (predict), then push the new return address
+        CHECK(fetch(0x500, JALR_RA_T0));
+        CHECK(last_target == 0x404);
+        peek_return(0x600, RET, true, 0x504, "Top replaced by pop-then-push");
+        fetch(0x600, RET);
+    }
+
+    void test_restore_on_flush() {
+
+        // A call leaves EX and updates the checkpoint
+        fetch(0x700, JAL_RA);
+        execute(0x700, false, 1, 0, false);
+
+        // Wrong-path calls are fetched speculatively...
+        fetch(0x800, JAL_RA);
+        fetch(0x900, JAL_RA);
+        peek_return(0xA00, RET, true, 0x904, "Speculative top");
+
+        // ...and discarded by the flush
+        restore();
+        peek_return(0xA00, RET, true, 0x704, "Restored from checkpoint");
+    }
+
+    void test_hit_counters() {
+
+        // The return predicted above leaves EX with the right target; another one mispredicts
+        execute(0xA00, true, 0, 1, false);
+        execute(0xB00, true, 0, 1, true);
+        CHECK(dut->rootp->return_address_stack__DOT__return_count == 2);
+        CHECK(dut->rootp->return_address_stack__DOT__return_hits == 1);
+    }
+
+    void test_restore_from_decode() {
+
+        // A call sits in ID (its push was speculative); the fetch queue behind it holds another call
+        fetch(0xC00, JAL_RA);
+        fetch(0xD00, JAL_RA);
+        peek_return(0xE00, RET, true, 0xD04, "Speculative top");
+
+        // The call redirects from ID: younger pushes are dropped, its own push is kept
+        restore_from_decode(0xC00, JAL_RA);
+        CHECK(fetch(0xE00, RET));
+        CHECK(last_target == 0xC04);
+        peek_return(0xE04, RET, false, 0, "Nothing below the replayed call");
+    }
+};
+
+TEST_CASE("Return Address Stack") {
+ReturnAddressStackTestbench tb;
+
+        tb.reset();
+        tb.test_empty();
+        tb.test_nested_calls();
+        tb.test_hints();
+        tb.test_restore_on_flush();
+        tb.test_hit_counters();
+        tb.test_restore_from_decode();
+}
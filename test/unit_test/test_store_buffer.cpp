@@ -0,0 +1,183 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "tb_base.h"
+#include "Vstore_buffer.h"
+#include <unordered_map>
+#include <vector>
+
+static constexpr int DEPTH = 4;
+static constexpr int CACHE_LATENCY = 3; // Stall cycles per cache access (write-through to memory)
+
+class StoreBufferTestbench : public ClockedTestbench<Vstore_buffer> {
+    // Cache model: every word reads as its own address until written
+    std::unordered_map<uint32_t, uint32_t> memory;
+    int wait_cycles = 0;
+
+public:
+    // Cache-side accesses in the order they completed
+    std::vector<uint32_t> write_log;
+    int cache_reads = 0;
+    uint32_t read_data = 0; // cpu_read_data sampled before the last edge
+
+    StoreBufferTestbench() : ClockedTestbench<Vstore_buffer>(100, false) {
+        dut->cpu_address = 0;
+        dut->cpu_write_data = 0;
+        dut->cpu_byte_enable = 0;
+        dut->cpu_write_enable = 0;
+        dut->cpu_read_enable = 0;
+        dut->cache_read_data = 0;
+        dut->cache_stall = 0;
+    }
+
+    void set_clk(uint8_t value) override {
+        dut->clk = value;
+    }
+
+    void reset() {
+        dut->rst_n = 0;
+        tick();
+        dut->rst_n = 1;
+        tick();
+    }
+
+    uint32_t read_memory(uint32_t addr) {
+        addr &= 0xFFFFFFFC;
+        return memory.count(addr) ? memory[addr] : addr;
+    }
+
+    // One clock: serve the cache port, then return whether the CPU was stalled before the edge
+    bool cycle() {
+        eval();
+        bool request = dut->cache_write_enable || dut->cache_read_enable;
+        dut->cache_stall = request && wait_cycles < CACHE_LATENCY;
+        dut->cache_read_data = read_memory(dut->cache_address);
+        eval();
+
+        if (request && !dut->cache_stall) {
+            uint32_t addr = dut->cache_address & 0xFFFFFFFC;
+            if (dut->cache_write_enable) {
+                uint32_t word = read_memory(addr);
+                for (int b = 0; b < 4; b++) {
+                    if (dut->cache_byte_enable & (1 << b)) {
+                        word = (word & ~(0xFFu << (b * 8))) | (dut->cache_write_data & (0xFFu << (b * 8)));
+                    }
+                }
+                memory[addr] = word;
+                write_log.push_back(addr);
+            } else {
+                cache_reads++;
+            }
+        }
+        wait_cycles = (request && dut->cache_stall) ? wait_cycles + 1 : 0;
+
+        bool stalled = dut->stall_cpu;
+        read_data = dut->cpu_read_data;
+        tick();
+        return stalled;
+    }
+
+    // Returns the number of cycles the CPU was stalled
+    int store(uint32_t addr, uint32_t data, uint8_t byte_enable = 0b1111) {
+        dut->cpu_address = addr;
+        dut->cpu_write_data = data;
+        dut->cpu_byte_enable = byte_enable;
+        dut->cpu_write_enable = 1;
+
+        int stalls = 0;
+        while (cycle()) {
+            stalls++;
+            REQUIRE(stalls < 100);
+        }
+        dut->cpu_write_enable = 0;
+        return stalls;
+    }
+
+    // Returns the data presented in the cycle the load completed
+    uint32_t load(uint32_t addr) {
+        dut->cpu_address = addr;
+        dut->cpu_byte_enable = 0;
+        dut->cpu_read_enable = 1;
+
+        int stalls = 0;
+        while (cycle()) {
+            stalls++;
+            REQUIRE(stalls < 100);
+        }
+        dut->cpu_read_enable = 0;
+        return read_data;
+    }
+
+    void drain() {
+        for (int i = 0; i < DEPTH * (CACHE_LATENCY + 2); i++) {
+            cycle();
+        }
+    }
+
+    void test_posted_stores() {
+        // A burst of stores up to the buffer depth retires without stalling
+        for (int i = 0; i < DEPTH; i++) {
+            CHECK(store(0x1000 + i * 4, 0x11110000 + i) == 0);
+        }
+
+        // The next store has to wait for a slot
+        CHECK(store(0x1000 + DEPTH * 4, 0x11110000 + DEPTH) > 0);
+
+        drain();
+
+        // Drained oldest first
+        REQUIRE(write_log.size() == DEPTH + 1);
+        for (int i = 0; i <= DEPTH; i++) {
+            CHECK(write_log[i] == 0x1000u + i * 4);
+            CHECK(read_memory(0x1000 + i * 4) == 0x11110000u + i);
+        }
+    }
+
+    void test_store_to_load_forwarding() {
+        write_log.clear();
+        cache_reads = 0;
+
+        // Full-word match in the buffer: served without a cache access
+        store(0x2000, 0xAAAA0000);
+        store(0x2000, 0xBBBB0000); // Younger store to the same word wins
+        CHECK(load(0x2000) == 0xBBBB0000);
+        CHECK(cache_reads == 0);
+
+        // Partial overlap: the pending byte is laid over the cache data
+        const uint32_t merged = (0x2104u & 0xFFFF00FF) | 0x00005A00;
+        store(0x2104, 0x00005A00, 0b0010);
+        CHECK(load(0x2104) == merged);
+        CHECK(cache_reads == 1);
+
+        drain();
+        CHECK(read_memory(0x2000) == 0xBBBB0000);
+        CHECK(read_memory(0x2104) == merged);
+    }
+
+    void test_uncached_load_ordering() {
+        write_log.clear();
+        cache_reads = 0;
+
+        // A peripheral load must not overtake the older peripheral store
+        store(0x40000000, 'A');
+        CHECK(load(0x40000004) == 0x40000004);
+        REQUIRE(write_log.size() == 1);
+        CHECK(write_log[0] == 0x40000000);
+        CHECK(cache_reads == 1);
+
+        // Same word (a device register): never forwarded, the load reaches the device after the store
+        store(0x40000008, 0x12345678);
+        CHECK(load(0x40000008) == 0x12345678);
+        REQUIRE(write_log.size() == 2);
+        CHECK(write_log[1] == 0x40000008);
+        CHECK(cache_reads == 2);
+    }
+};
+
+TEST_CASE("Store Buffer") {
+StoreBufferTestbench tb;
+
+        tb.reset();
+        tb.test_posted_stores();
+        tb.test_store_to_load_forwarding();
+        tb.test_uncached_load_ordering();
+}